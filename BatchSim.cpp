@@ -0,0 +1,246 @@
+#include "BatchSim.hpp"
+#include "Deal.hpp"
+#include <cassert>
+
+using namespace std;
+
+// Choices are made with masks rather than branches: which card a Simple
+// player picks depends on the deal, so branches on it are mispredicted
+// about as often as not.
+
+// EFFECTS: Returns if_set if condition is not zero, and otherwise if_clear
+static inline uint64_t select(uint64_t condition, uint64_t if_set,
+                              uint64_t if_clear) {
+  uint64_t mask = 0 - uint64_t(condition != 0);
+  return (if_set & mask) | (if_clear & ~mask);
+}
+
+// EFFECTS: Returns the highest set bit of bits, or 0 if there is none
+static inline uint64_t top_bit(uint64_t bits) {
+  return select(bits, uint64_t(1) << (63 - __builtin_clzll(bits | 1)), 0);
+}
+
+// EFFECTS: Returns the lowest set bit of bits, or 0 if there is none
+static inline uint64_t low_bit(uint64_t bits) {
+  return bits & (0 - bits);
+}
+
+// EFFECTS: Returns the face cards and aces of cards in hand
+static inline uint64_t face_or_ace(uint64_t hand, uint64_t cards) {
+  return hand & cards & CardSet::FACE_OR_ACE_BITS;
+}
+
+// EFFECTS: Returns true if bits has two or more set bits
+static inline bool two_or_more(uint64_t bits) {
+  return (bits & (bits - 1)) != 0;
+}
+
+// For each trump, every card's place in the order Card_less puts the
+// cards in: the cards that are not trump by Card_index, then the trumps
+// from weakest to the right bower. Also the inverse, and the places of
+// the trumps and of each suit once trump is considered.
+struct TrumpOrderTable {
+  int8_t position[4][NUM_CARD_INDICES];
+  Card card[4][NUM_CARD_INDICES];
+  uint64_t trumps[4];
+  uint64_t suits[4][4];
+};
+
+static TrumpOrderTable make_trump_order_table() {
+  TrumpOrderTable order = {};
+  for (int t = SPADES; t <= DIAMONDS; ++t) {
+    Suit trump = static_cast<Suit>(t);
+    for (int i = 0; i < NUM_CARD_INDICES; ++i) {
+      Card card = Card_from_index(i);
+      int position = 0;
+      for (int j = 0; j < NUM_CARD_INDICES; ++j) {
+        position += Card_less(Card_from_index(j), card, trump);
+      }
+      uint64_t bit = uint64_t(1) << position;
+      order.position[t][i] = position;
+      order.card[t][position] = card;
+      order.suits[t][card.get_suit(trump)] |= bit;
+      if (card.is_trump(trump)) {
+        order.trumps[t] |= bit;
+      }
+    }
+  }
+  return order;
+}
+
+static const TrumpOrderTable TRUMP_ORDER = make_trump_order_table();
+
+// REQUIRES: hand holds CardSet bits
+// EFFECTS: Returns hand with each card's bit at its place in trump order
+static inline uint64_t in_trump_order(uint64_t hand, Suit trump) {
+  uint64_t ordered = 0;
+  for (; hand != 0; hand &= hand - 1) {
+    ordered |= uint64_t(1) << TRUMP_ORDER.position[trump][__builtin_ctzll(hand)];
+  }
+  return ordered;
+}
+
+BatchSim::BatchSim(const Pack &pack, int points_to_win_in) :
+  first_pack(pack), points_to_win(points_to_win_in) {
+  assert(points_to_win >= 1);
+  for (int lane = 0; lane < LANES; ++lane) {
+    start_game(lane, 0, -1);
+  }
+}
+
+// Starts game index in lane, as Game::reset(Rng(seed, index)) does. An
+// idle lane, with index -1, plays on so that every lane stays in step.
+void BatchSim::start_game(int lane, uint64_t seed, long long index) {
+  game[lane] = index;
+  packs[lane] = first_pack;
+  rngs[lane] = Rng(seed, index);
+  dealer[lane] = 0;
+  hands_played[lane] = 0;
+  scores[0][lane] = 0;
+  scores[1][lane] = 0;
+  euchres[lane] = 0;
+  marches[lane] = 0;
+}
+
+void BatchSim::play(uint64_t seed, long long first, long long count,
+                    GameResult *results) {
+  assert(count >= 0);
+  long long next = first;
+  long long end = first + count;
+  int active = 0;
+  for (int lane = 0; lane < LANES; ++lane) {
+    start_game(lane, seed, next < end ? next++ : -1);
+    active += game[lane] >= 0;
+  }
+
+  while (active > 0) {
+    deal();
+    make_trump();
+    for (int trick = 0; trick < Player::MAX_HAND_SIZE; ++trick) {
+      play_trick();
+    }
+    award_score();
+
+    for (int lane = 0; lane < LANES; ++lane) {
+      if (scores[0][lane] < points_to_win && scores[1][lane] < points_to_win) {
+        continue;
+      }
+      if (game[lane] >= 0) {
+        results[game[lane] - first] = lane_result(lane);
+        active--;
+      }
+      start_game(lane, seed, next < end ? next++ : -1);
+      active += game[lane] >= 0;
+    }
+  }
+}
+
+void BatchSim::deal() {
+  for (int lane = 0; lane < LANES; ++lane) {
+    Pack &pack = packs[lane];
+    pack.shuffle(rngs[lane]);
+    for (int seat = 0; seat < 4; ++seat) {
+      hands[seat][lane] = 0;
+    }
+    // As Game::deal, from the left of the dealer in batches of three and two
+    for (int batch = 0; batch < 8; ++batch) {
+      int seat = (dealer[lane] + 1 + batch) % 4;
+      for (int j = 0; j < DEAL_BATCHES[batch]; ++j) {
+        hands[seat][lane] |= CardSet::bit(pack.deal_one());
+      }
+    }
+    upcard[lane] = pack.deal_one();
+  }
+}
+
+// Each seat bids as SimplePlayer does: in round one it orders up with two
+// or more face cards or aces of trump, and in round two with one or more
+// of the next suit. The dealer always orders up in round two.
+void BatchSim::make_trump() {
+  for (int lane = 0; lane < LANES; ++lane) {
+    const Card &up = upcard[lane];
+    int dealer_seat = dealer[lane];
+    uint64_t round1 = CardSet_trump(up.get_suit()).get_bits();
+    uint64_t round2 = CardSet_suit(Suit_next(up.get_suit())).get_bits();
+    // Bit i - 1 is set if the seat i to the left of the dealer would order
+    // up in round one, and bit i + 3 if it would in round two
+    int bids = 1 << 7;
+    for (int i = 1; i <= 4; ++i) {
+      uint64_t hand = hands[(dealer_seat + i) % 4][lane];
+      bids |= two_or_more(face_or_ace(hand, round1)) << (i - 1);
+      bids |= (face_or_ace(hand, round2) != 0) << (i + 3);
+    }
+    int first_bid = __builtin_ctz(bids);
+    bool first_round = first_bid < 4;
+    int maker = (dealer_seat + 1 + first_bid % 4) % 4;
+
+    Suit suit = first_round ? up.get_suit() : Suit_next(up.get_suit());
+    trump[lane] = suit;
+    for (int seat = 0; seat < 4; ++seat) {
+      hands[seat][lane] = in_trump_order(hands[seat][lane], suit);
+    }
+    // In round one the dealer picks up the upcard and discards its lowest
+    // card, as add_and_discard does
+    uint64_t &hand = hands[dealer_seat][lane];
+    uint64_t picked_up =
+      hand | uint64_t(1) << TRUMP_ORDER.position[suit][Card_index(up)];
+    picked_up &= ~low_bit(picked_up);
+    hand = select(first_round, picked_up, hand);
+
+    team1_ordered_up[lane] = maker % 2 == 0;
+    leader[lane] = (dealer_seat + 1) % 4;
+    team1_tricks[lane] = 0;
+  }
+}
+
+// Each seat plays as SimplePlayer does: the leader leads its highest
+// non-trump card, or its highest trump, and the others follow suit high
+// or else play low. In trump order each choice is a top or bottom bit.
+void BatchSim::play_trick() {
+  Suit led_suit[LANES];
+  for (int lane = 0; lane < LANES; ++lane) {
+    Suit t = trump[lane];
+    uint64_t &hand = hands[leader[lane]][lane];
+    uint64_t non_trumps = hand & ~TRUMP_ORDER.trumps[t];
+    uint64_t led = select(non_trumps, top_bit(non_trumps), top_bit(hand));
+    hand &= ~led;
+    tricks[lane][0] = TRUMP_ORDER.card[t][__builtin_ctzll(led)];
+    led_suit[lane] = tricks[lane][0].get_suit(t);
+  }
+  for (int i = 1; i < TRICK_SIZE; ++i) {
+    for (int lane = 0; lane < LANES; ++lane) {
+      Suit t = trump[lane];
+      uint64_t &hand = hands[(leader[lane] + i) % 4][lane];
+      uint64_t follow = hand & TRUMP_ORDER.suits[t][led_suit[lane]];
+      uint64_t card = select(follow, top_bit(follow), low_bit(hand));
+      hand &= ~card;
+      tricks[lane][i] = TRUMP_ORDER.card[t][__builtin_ctzll(card)];
+    }
+  }
+
+  Trick_winners(tricks[0], trump, LANES, winners);
+  for (int lane = 0; lane < LANES; ++lane) {
+    leader[lane] = (leader[lane] + winners[lane]) % 4;
+    team1_tricks[lane] += leader[lane] % 2 == 0;
+  }
+}
+
+void BatchSim::award_score() {
+  for (int lane = 0; lane < LANES; ++lane) {
+    HandScore score = score_hand(team1_tricks[lane], team1_ordered_up[lane]);
+    scores[score.winning_team][lane] += score.points;
+    euchres[lane] += score.euchred;
+    marches[lane] += score.march;
+    hands_played[lane]++;
+    dealer[lane] = (dealer[lane] + 1) % 4;
+  }
+}
+
+GameResult BatchSim::lane_result(int lane) const {
+  GameResult result;
+  result.winning_team = scores[0][lane] > scores[1][lane] ? 0 : 1;
+  result.hands = hands_played[lane];
+  result.euchres = euchres[lane];
+  result.marches = marches[lane];
+  return result;
+}
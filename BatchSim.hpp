@@ -0,0 +1,82 @@
+#ifndef BATCHSIM_HPP
+#define BATCHSIM_HPP
+/* BatchSim.hpp
+ *
+ * Plays many games between four Simple players in lockstep
+ */
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include <cstdint>
+
+// Plays games between four Simple players LANES at a time. Each lane holds
+// one game, and all lanes move through the deal, the bidding, each trick
+// and the scoring of a hand together. Game state is a structure of arrays,
+// one array per field indexed by lane, and hands are CardSet bitmasks, so
+// each phase is one branch-light loop over the lanes with no players,
+// names, logging or virtual calls. The tricks of every lane are resolved
+// by one Trick_winners call. When a lane's game ends, the lane starts the
+// next game of the run, so lanes only sit idle at the end of a run.
+//
+// Game n of a run starts from the simulator's pack, shuffles with
+// Rng(seed, n) and is dealt first by player 0. That is exactly what Game
+// does after reset(Rng(seed, n)) with four Simple players, and the rules
+// are the same, so each game's result is the same as Game's.
+//
+// A simulator is not safe to share between threads.
+class BatchSim {
+public:
+  // Games played at once
+  static const int LANES = 16;
+
+  // EFFECTS: Creates a simulator whose games start from a copy of pack
+  //          and are played to points_to_win
+  BatchSim(const Pack &pack, int points_to_win);
+
+  // REQUIRES: count >= 0 and results holds count results
+  // MODIFIES: results
+  // EFFECTS: Plays games first through first + count - 1, shuffling game
+  //          n with Rng(seed, n), and sets results[n - first] to the
+  //          result of game n
+  void play(uint64_t seed, long long first, long long count,
+            GameResult *results);
+
+private:
+  Pack first_pack;
+  int points_to_win;
+
+  // The state of each lane's game
+  long long game[LANES];       // the game's number, or -1 if the lane is idle
+  Pack packs[LANES];
+  Rng rngs[LANES];
+  int dealer[LANES];
+  int hands_played[LANES];
+  int scores[2][LANES];        // of players 0 and 2, and of players 1 and 3
+  int euchres[LANES];
+  int marches[LANES];
+
+  // The state of each lane's current hand. Hands are CardSet bits while
+  // the lanes bid. Once trump is made, each card's bit moves to its place
+  // in the lane's trump order, lowest first, so that Simple's choices are
+  // the top or bottom bit of a hand or of one suit of it.
+  uint64_t hands[4][LANES];    // by seat
+  Card upcard[LANES];
+  Suit trump[LANES];
+  bool team1_ordered_up[LANES];
+  int leader[LANES];
+  int team1_tricks[LANES];
+  Card tricks[LANES][TRICK_SIZE];
+  int winners[LANES];
+
+  void start_game(int lane, uint64_t seed, long long index);
+  void deal();
+  void make_trump();
+  void play_trick();
+  void award_score();
+  GameResult lane_result(int lane) const;
+};
+
+#endif // BATCHSIM_HPP
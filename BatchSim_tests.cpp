@@ -0,0 +1,83 @@
+#include "BatchSim.hpp"
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// EFFECTS: Returns the results of games first through first + count - 1,
+//          each played by Game with four Simple players
+static vector<GameResult> game_results(const Pack &pack, int points_to_win,
+                                       uint64_t seed, int count) {
+    vector<pair<string, string>> players = {
+        {"Adi", "Simple"}, {"Barbara", "Simple"},
+        {"Chi-Chih", "Simple"}, {"Dabbala", "Simple"}};
+    Game game(pack, points_to_win, true, players);
+    ostringstream os;
+    GameLog log(os, LOG_NONE);
+    vector<GameResult> results;
+    for (int n = 0; n < count; ++n) {
+        game.reset(Rng(seed, 100 + n));
+        results.push_back(game.play(log));
+    }
+    return results;
+}
+
+// EFFECTS: Asserts that each of actual is the same result as expected
+static void assert_same_results(const vector<GameResult> &actual,
+                                const vector<GameResult> &expected) {
+    ASSERT_EQUAL(actual.size(), expected.size());
+    for (size_t n = 0; n < actual.size(); ++n) {
+        ASSERT_EQUAL(actual[n].winning_team, expected[n].winning_team);
+        ASSERT_EQUAL(actual[n].hands, expected[n].hands);
+        ASSERT_EQUAL(actual[n].euchres, expected[n].euchres);
+        ASSERT_EQUAL(actual[n].marches, expected[n].marches);
+    }
+}
+
+// Lanes finish at different hands and take new games, so many more games
+// than lanes exercise every way a lane can move on
+TEST(test_batch_matches_game) {
+    const int count = 5 * BatchSim::LANES + 3;
+    for (int points_to_win : {1, 5, 10}) {
+        BatchSim sim(Pack(), points_to_win);
+        vector<GameResult> results(count);
+        sim.play(12, 100, count, results.data());
+        assert_same_results(results, game_results(Pack(), points_to_win, 12,
+                                                  count));
+    }
+}
+
+// Games start from the simulator's pack, as they do from Game's
+TEST(test_batch_matches_game_other_pack) {
+    Pack pack;
+    pack.shuffle(OUT_SHUFFLE, 3);
+    BatchSim sim(pack, 10);
+    vector<GameResult> results(BatchSim::LANES);
+    sim.play(3, 100, results.size(), results.data());
+    assert_same_results(results, game_results(pack, 10, 3, results.size()));
+}
+
+// Fewer games than lanes, and none at all, leave the other lanes idle
+TEST(test_batch_partial_runs) {
+    BatchSim sim(Pack(), 10);
+    GameResult unused;
+    unused.hands = -1;
+    sim.play(12, 100, 0, &unused);
+    ASSERT_EQUAL(unused.hands, -1);
+
+    vector<GameResult> results(3);
+    sim.play(12, 100, results.size(), results.data());
+    assert_same_results(results, game_results(Pack(), 10, 12, 3));
+
+    // A simulator can be reused for another run
+    vector<GameResult> again(3);
+    sim.play(12, 100, again.size(), again.data());
+    assert_same_results(again, results);
+}
+
+TEST_MAIN()
@@ -0,0 +1,198 @@
+#include "BidTable.hpp"
+#include "Deal.hpp"
+#include "Player.hpp"
+#include <cassert>
+#include <memory>
+
+using namespace std;
+
+static const int HAND_SIZE = Player::MAX_HAND_SIZE;
+static const int UPCARD_RANKS = ACE - NINE + 1;
+
+static const char MAGIC[] = {'E', 'U', 'C', 'B'};
+static const char VERSION = 1;
+
+// Numbers the hands that are canonical relative to SPADES, in order of
+// Hand_rank. Other hands are numbered -1.
+struct HandClasses {
+  vector<int> class_of;
+  int count = 0;
+
+  HandClasses() : class_of(NUM_HANDS, -1) {
+    for (int index = 0; index < NUM_HANDS; ++index) {
+      CardSet hand = Hand_unrank(index);
+      if (CardSet_canonical(hand, SPADES) == hand) {
+        class_of[index] = count++;
+      }
+    }
+  }
+};
+
+static const HandClasses & hand_classes() {
+  static const HandClasses classes;
+  return classes;
+}
+
+int BidTable::num_keys() {
+  return hand_classes().count * UPCARD_RANKS * 4;
+}
+
+bool BidTable::covers(const BidSituation &situation) {
+  const CardSet euchre(CardSet::EUCHRE_BITS);
+  return situation.hand.size() == HAND_SIZE &&
+         (situation.hand & euchre) == situation.hand &&
+         euchre.contains(situation.upcard) &&
+         !situation.hand.contains(situation.upcard);
+}
+
+int BidTable::key(const BidSituation &situation, SuitMap &map) {
+  assert(covers(situation));
+  assert(situation.round == 1 || situation.round == 2);
+  map = SuitMap_canonical(situation.hand, situation.upcard.get_suit());
+  int hand_class = hand_classes().class_of[Hand_rank(map(situation.hand))];
+  assert(hand_class >= 0);
+  int upcard_rank = situation.upcard.get_rank() - NINE;
+  return ((hand_class * UPCARD_RANKS + upcard_rank) * 2 +
+          situation.is_dealer) * 2 + situation.round - 1;
+}
+
+BidTable::BidTable() : choices(num_keys(), PASS) {}
+
+bool BidTable::make_trump(const BidSituation &situation,
+                          Suit &order_up_suit) const {
+  SuitMap map;
+  int k = key(situation, map);
+  int choice = choices[k];
+  if (choice == PASS) {
+    return false;
+  }
+  order_up_suit = SuitMap_inverse(map)(static_cast<Suit>(choice - 1));
+  return true;
+}
+
+void BidTable::set_choice(int key, int choice) {
+  assert(0 <= choice && choice < NUM_CHOICES);
+  choices[key] = static_cast<int8_t>(choice);
+}
+
+float BidTable::get_value(int key, int choice) const {
+  assert(0 <= choice && choice < NUM_CHOICES);
+  return values.empty() ? 0 : values[key * NUM_CHOICES + choice];
+}
+
+void BidTable::set_value(int key, int choice, float value) {
+  assert(0 <= choice && choice < NUM_CHOICES);
+  if (values.empty()) {
+    values.assign(choices.size() * NUM_CHOICES, 0);
+  }
+  values[key * NUM_CHOICES + choice] = value;
+}
+
+void BidTable::choose_best() {
+  for (int k = 0; k < num_keys(); ++k) {
+    bool round_two = k % 2 == 1;
+    bool is_dealer = (k / 2) % 2 == 1;
+    int best = -1;
+    for (int choice = 0; choice < NUM_CHOICES; ++choice) {
+      bool legal = choice == PASS ? !(round_two && is_dealer)
+                                  : round_two != (choice == choice_of(SPADES));
+      if (legal && (best == -1 || get_value(k, choice) > get_value(k, best))) {
+        best = choice;
+      }
+    }
+    choices[k] = static_cast<int8_t>(best);
+  }
+}
+
+// The table is the header, a byte that is 1 if there are expected values,
+// the number of keys as four bytes from the lowest, one byte per choice,
+// then NUM_CHOICES floats per key in the machine's byte order.
+void BidTable::write(ostream &os) const {
+  os.write(MAGIC, sizeof(MAGIC));
+  os.put(VERSION);
+  os.put(has_values() ? 1 : 0);
+  uint32_t count = choices.size();
+  for (int byte = 0; byte < 4; ++byte) {
+    os.put(static_cast<char>(count >> (8 * byte)));
+  }
+  os.write(reinterpret_cast<const char *>(choices.data()), choices.size());
+  if (has_values()) {
+    os.write(reinterpret_cast<const char *>(values.data()),
+             values.size() * sizeof(float));
+  }
+}
+
+bool BidTable::read(istream &is) {
+  char header[sizeof(MAGIC) + 6];
+  if (!is.read(header, sizeof(header)) ||
+      string(header, sizeof(MAGIC)) != string(MAGIC, sizeof(MAGIC)) ||
+      header[sizeof(MAGIC)] != VERSION) {
+    return false;
+  }
+  bool with_values = header[sizeof(MAGIC) + 1] == 1;
+  uint32_t count = 0;
+  for (int byte = 0; byte < 4; ++byte) {
+    count |= uint32_t(static_cast<unsigned char>(
+                 header[sizeof(MAGIC) + 2 + byte])) << (8 * byte);
+  }
+  if (count != choices.size()) {
+    return false;
+  }
+
+  vector<int8_t> new_choices(count);
+  vector<float> new_values(with_values ? count * NUM_CHOICES : 0);
+  if (!is.read(reinterpret_cast<char *>(new_choices.data()), count) ||
+      !is.read(reinterpret_cast<char *>(new_values.data()),
+               new_values.size() * sizeof(float))) {
+    return false;
+  }
+  for (int8_t choice : new_choices) {
+    if (choice < 0 || choice >= NUM_CHOICES) {
+      return false;
+    }
+  }
+  choices.swap(new_choices);
+  values.swap(new_values);
+  return true;
+}
+
+BidTable BidTable_build(const string &strategy) {
+  BidTable table;
+  const vector<int> &class_of = hand_classes().class_of;
+  for (int index = 0; index < NUM_HANDS; ++index) {
+    if (class_of[index] == -1) {
+      continue;
+    }
+    BidSituation situation;
+    situation.hand = Hand_unrank(index);
+    unique_ptr<Player> bidder(Player_factory("Table", strategy));
+    for (CardSet cards = situation.hand; !cards.empty();
+         cards.remove(cards.lowest())) {
+      bidder->add_card(cards.lowest());
+    }
+
+    for (int rank = NINE; rank <= ACE; ++rank) {
+      situation.upcard = Card(static_cast<Rank>(rank), SPADES);
+      if (situation.hand.contains(situation.upcard)) {
+        continue;
+      }
+      for (int k = 0; k < 4; ++k) {
+        situation.is_dealer = k / 2 == 1;
+        situation.round = 1 + k % 2;
+        Suit suit = SPADES;
+        bool ordered = bidder->make_trump(situation.upcard,
+                                          situation.is_dealer,
+                                          situation.round, suit);
+        SuitMap map;
+        table.set_choice(BidTable::key(situation, map),
+                         ordered ? BidTable::choice_of(suit) : BidTable::PASS);
+      }
+    }
+  }
+  return table;
+}
+
+const BidTable & BidTable_simple() {
+  static const BidTable table = BidTable_build("Simple");
+  return table;
+}
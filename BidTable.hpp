@@ -0,0 +1,110 @@
+#ifndef BIDTABLE_HPP
+#define BIDTABLE_HPP
+/* BidTable.hpp
+ *
+ * Precomputed bidding decisions, and expected values, for every hand
+ */
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "SuitMap.hpp"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Everything a bidder is told when asked to make trump
+struct BidSituation {
+  CardSet hand;         // five distinct euchre cards
+  Card upcard;
+  bool is_dealer = false;
+  int round = 1;        // 1 or 2
+};
+
+// A decision for every bidding situation: pass, or order up a suit.
+//
+// Situations are canonicalized with SuitMap_canonical relative to the
+// upcard suit, so the upcard is always a spade and hands that differ only
+// by swapping the two suits of the other colour share one entry. That
+// leaves 22398 hands, six upcard ranks, dealer or not, and two rounds, so
+// the decisions take about half a megabyte and a lookup is a
+// relabelling, a hand rank and two array reads.
+//
+// Each entry may also hold an expected value for each choice, for example
+// points won on average in simulation. choose_best turns those into
+// decisions, so a stronger bidder costs the same to consult.
+class BidTable {
+public:
+  // Choices, numbered from 0: pass, then order up each canonical suit
+  static constexpr int PASS = 0;
+  static constexpr int NUM_CHOICES = 5;
+
+  // EFFECTS: Returns the choice that orders up suit
+  static int choice_of(Suit suit) { return 1 + suit; }
+
+  // EFFECTS: Returns the number of entries, one per canonical situation
+  static int num_keys();
+
+  // EFFECTS: Returns true if the table has an entry for situation: its
+  //          hand is five distinct euchre cards without the upcard
+  static bool covers(const BidSituation &situation);
+
+  // REQUIRES: covers(situation)
+  // EFFECTS: Returns the entry for situation, and sets map to the
+  //          relabelling that made the situation canonical
+  static int key(const BidSituation &situation, SuitMap &map);
+
+  // EFFECTS: Initializes a table that passes in every situation, without
+  //          expected values
+  BidTable();
+
+  // REQUIRES: covers(situation)
+  // MODIFIES: order_up_suit
+  // EFFECTS: Returns true and sets order_up_suit if the table orders up in
+  //          situation, or false if it passes
+  bool make_trump(const BidSituation &situation, Suit &order_up_suit) const;
+
+  // REQUIRES: 0 <= key < num_keys()
+  int get_choice(int key) const { return choices[key]; }
+
+  // REQUIRES: 0 <= key < num_keys() and 0 <= choice < NUM_CHOICES
+  void set_choice(int key, int choice);
+
+  // EFFECTS: Returns true once any expected value has been set
+  bool has_values() const { return !values.empty(); }
+
+  // REQUIRES: 0 <= key < num_keys() and 0 <= choice < NUM_CHOICES
+  // EFFECTS: Returns the expected value of choice, 0 if none was set
+  float get_value(int key, int choice) const;
+
+  // REQUIRES: 0 <= key < num_keys() and 0 <= choice < NUM_CHOICES
+  void set_value(int key, int choice, float value);
+
+  // EFFECTS: Sets each choice to the legal choice of highest expected
+  //          value: passing or ordering up the upcard suit in round 1, and
+  //          any other suit in round 2, where the dealer may not pass
+  void choose_best();
+
+  // EFFECTS: Writes the table to os in a binary format read by read
+  void write(std::ostream &os) const;
+
+  // MODIFIES: is
+  // EFFECTS: Reads a table written by write. Returns false, leaving the
+  //          table unchanged, if is does not hold one.
+  bool read(std::istream &is);
+
+private:
+  std::vector<int8_t> choices;
+  std::vector<float> values;  // NUM_CHOICES per key, or empty
+};
+
+//REQUIRES strategy is a strategy of Player_factory whose bids depend only
+//  on its hand and the arguments of make_trump
+//EFFECTS Returns a table of the bids of strategy in every situation
+BidTable BidTable_build(const std::string &strategy);
+
+//EFFECTS Returns the table of the "Simple" strategy's bids, built the
+//  first time it is needed
+const BidTable & BidTable_simple();
+
+#endif // BIDTABLE_HPP
@@ -0,0 +1,212 @@
+#include "BidTable.hpp"
+#include "Deal.hpp"
+#include "Player.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// EFFECTS: Returns a player of strategy holding hand
+static unique_ptr<Player> holding(const string &strategy, CardSet hand) {
+    unique_ptr<Player> player(Player_factory("Bidder", strategy));
+    for (; !hand.empty(); hand.remove(hand.lowest())) {
+        player->add_card(hand.lowest());
+    }
+    return player;
+}
+
+// The table of Simple bids agrees with SimplePlayer on every hand, for an
+// upcard of each suit and each rank
+TEST(test_bid_table_simple_matches_player) {
+    const BidTable &table = BidTable_simple();
+    for (int index = 0; index < NUM_HANDS; ++index) {
+        BidSituation situation;
+        situation.hand = Hand_unrank(index);
+        situation.upcard = Card(static_cast<Rank>(NINE + index % 6),
+                                static_cast<Suit>(index / 6 % 4));
+        if (situation.hand.contains(situation.upcard)) {
+            continue;
+        }
+        unique_ptr<Player> simple = holding("Simple", situation.hand);
+        for (int k = 0; k < 4; ++k) {
+            situation.is_dealer = k / 2 == 1;
+            situation.round = 1 + k % 2;
+            Suit simple_suit = SPADES;
+            Suit table_suit = SPADES;
+            bool simple_bid = simple->make_trump(situation.upcard,
+                                                 situation.is_dealer,
+                                                 situation.round, simple_suit);
+            ASSERT_EQUAL(table.make_trump(situation, table_suit), simple_bid);
+            if (simple_bid) {
+                ASSERT_EQUAL(table_suit, simple_suit);
+            }
+        }
+    }
+}
+
+TEST(test_bid_table_keys) {
+    // 22398 canonical hands, six upcard ranks, dealer or not, two rounds
+    ASSERT_EQUAL(BidTable::num_keys(), 22398 * 6 * 2 * 2);
+
+    BidSituation situation;
+    situation.upcard = Card(JACK, HEARTS);
+    situation.hand.add(Card(NINE, SPADES));
+    ASSERT_FALSE(BidTable::covers(situation));
+    situation.hand.add(Card(TEN, SPADES));
+    situation.hand.add(Card(ACE, DIAMONDS));
+    situation.hand.add(Card(JACK, DIAMONDS));
+    situation.hand.add(Card(QUEEN, CLUBS));
+    ASSERT_TRUE(BidTable::covers(situation));
+
+    set<int> keys;
+    for (Suit upcard_suit : {SPADES, HEARTS, CLUBS, DIAMONDS}) {
+        for (int round = 1; round <= 2; ++round) {
+            for (bool dealer : {false, true}) {
+                SuitMap map;
+                situation.upcard = Card(KING, upcard_suit);
+                situation.round = round;
+                situation.is_dealer = dealer;
+                int key = BidTable::key(situation, map);
+                ASSERT_TRUE(0 <= key && key < BidTable::num_keys());
+                ASSERT_EQUAL(map(upcard_suit), SPADES);
+                keys.insert(key);
+            }
+        }
+    }
+    // Four keys for each upcard suit, one for each round and seat
+    ASSERT_EQUAL(keys.size() % 4, size_t(0));
+    ASSERT_TRUE(keys.size() >= 4);
+
+    SuitMap map;
+    situation.hand = CardSet();
+    for (const Card &card : {Card(NINE, SPADES), Card(TEN, SPADES),
+                             Card(NINE, HEARTS), Card(TEN, HEARTS),
+                             Card(NINE, DIAMONDS)}) {
+        situation.hand.add(card);
+    }
+    situation.upcard = Card(ACE, SPADES);
+    int key = BidTable::key(situation, map);
+    BidSituation swapped = situation;
+    swapped.hand = SuitMap_from(SPADES, true)(situation.hand);
+    ASSERT_EQUAL(BidTable::key(swapped, map), key);
+}
+
+// Values choose the best legal bid, and the dealer may not pass in round 2
+TEST(test_bid_table_choose_best) {
+    BidTable table;
+    ASSERT_FALSE(table.has_values());
+    BidSituation situation;
+    for (const Card &card : {Card(NINE, CLUBS), Card(ACE, CLUBS),
+                             Card(KING, HEARTS), Card(TEN, DIAMONDS),
+                             Card(QUEEN, SPADES)}) {
+        situation.hand.add(card);
+    }
+    situation.upcard = Card(NINE, HEARTS);
+    SuitMap map;
+
+    situation.round = 1;
+    int first = BidTable::key(situation, map);
+    table.set_value(first, BidTable::PASS, -0.5f);
+    table.set_value(first, BidTable::choice_of(SPADES), 0.25f);
+    table.set_value(first, BidTable::choice_of(CLUBS), 3.0f); // not legal
+
+    situation.round = 2;
+    situation.is_dealer = true;
+    int second = BidTable::key(situation, map);
+    table.set_value(second, BidTable::PASS, 5.0f); // not legal
+    table.set_value(second, BidTable::choice_of(DIAMONDS), 1.0f);
+    table.set_value(second, BidTable::choice_of(CLUBS), -1.0f);
+
+    ASSERT_TRUE(table.has_values());
+    table.choose_best();
+    ASSERT_EQUAL(table.get_choice(first), BidTable::choice_of(SPADES));
+    ASSERT_EQUAL(table.get_choice(second), BidTable::choice_of(DIAMONDS));
+
+    Suit suit = SPADES;
+    situation.round = 1;
+    situation.is_dealer = false;
+    ASSERT_TRUE(table.make_trump(situation, suit));
+    ASSERT_EQUAL(suit, HEARTS);
+    situation.round = 2;
+    situation.is_dealer = true;
+    ASSERT_TRUE(table.make_trump(situation, suit));
+    ASSERT_EQUAL(suit, SuitMap_inverse(map)(DIAMONDS));
+    // Situations without values pass
+    situation.is_dealer = false;
+    ASSERT_FALSE(table.make_trump(situation, suit));
+}
+
+TEST(test_bid_table_write_read) {
+    BidTable table;
+    table.set_choice(7, BidTable::choice_of(SPADES));
+    table.set_value(11, 3, 2.5f);
+    stringstream stream;
+    table.write(stream);
+
+    BidTable copy;
+    ASSERT_TRUE(copy.read(stream));
+    ASSERT_EQUAL(copy.get_choice(7), BidTable::choice_of(SPADES));
+    ASSERT_EQUAL(copy.get_choice(8), BidTable::PASS);
+    ASSERT_TRUE(copy.has_values());
+    ASSERT_EQUAL(copy.get_value(11, 3), 2.5f);
+
+    string bytes = stream.str();
+    istringstream truncated(bytes.substr(0, bytes.size() - 1));
+    BidTable unchanged;
+    ASSERT_FALSE(unchanged.read(truncated));
+    ASSERT_EQUAL(unchanged.get_choice(7), BidTable::PASS);
+    istringstream garbage("EUCRxxxxxxxxxx");
+    ASSERT_FALSE(unchanged.read(garbage));
+}
+
+// The "Table" strategy bids from the Simple table or from a file
+TEST(test_bid_table_player) {
+    ASSERT_TRUE(Player_strategy_valid("Table"));
+    ASSERT_FALSE(Player_strategy_valid("Table:no_such_bid_table.bin"));
+
+    BidTable always;
+    for (int key = 0; key < BidTable::num_keys(); ++key) {
+        always.set_choice(key, key % 2 == 0 ? BidTable::choice_of(SPADES)
+                                             : BidTable::choice_of(CLUBS));
+    }
+    const string filename = "BidTable_tests_always.bin";
+    {
+        ofstream fout(filename, ios::binary);
+        always.write(fout);
+    }
+    ASSERT_TRUE(Player_strategy_valid("Table:" + filename));
+
+    CardSet hand;
+    for (const Card &card : {Card(NINE, CLUBS), Card(ACE, CLUBS),
+                             Card(KING, HEARTS), Card(TEN, DIAMONDS),
+                             Card(QUEEN, SPADES)}) {
+        hand.add(card);
+    }
+    unique_ptr<Player> table_player = holding("Table:" + filename, hand);
+    unique_ptr<Player> simple_table = holding("Table", hand);
+    unique_ptr<Player> simple = holding("Simple", hand);
+    remove(filename.c_str());
+
+    Card upcard(JACK, DIAMONDS);
+    Suit suit = SPADES;
+    Suit simple_suit = SPADES;
+    ASSERT_TRUE(table_player->make_trump(upcard, false, 1, suit));
+    ASSERT_EQUAL(suit, DIAMONDS);
+    ASSERT_TRUE(table_player->make_trump(upcard, false, 2, suit));
+    ASSERT_EQUAL(suit, HEARTS);
+    for (int round = 1; round <= 2; ++round) {
+        ASSERT_EQUAL(simple_table->make_trump(upcard, false, round, suit),
+                     simple->make_trump(upcard, false, round, simple_suit));
+    }
+    // Otherwise it plays as Simple does
+    ASSERT_EQUAL(table_player->lead_card(HEARTS), simple->lead_card(HEARTS));
+}
+
+TEST_MAIN()
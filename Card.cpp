@@ -1,8 +1,16 @@
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
 #include <array>
 #include "Card.hpp"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CARD_SSE2
+#endif
+
 using namespace std;
 
 /////////////// Rank operator implementations - DO NOT CHANGE ///////////////
@@ -94,44 +102,112 @@ std::istream & operator>>(std::istream &is, Suit &suit) {
 
 /////////////// Write your implementation for Card below ///////////////
 
+//EFFECTS Returns the name of rank, for example "Two"
+const char * Rank_name(Rank rank) {
+  return RANK_NAMES[rank];
+}
+
+//EFFECTS Returns the name of suit, for example "Spades"
+const char * Suit_name(Suit suit) {
+  return SUIT_NAMES[suit];
+}
+
+// Names are found with a perfect hash of their length and first two
+// letters, then checked in full. The hashes were chosen so no two names
+// of the same table collide.
+static constexpr int rank_hash(const char *name, size_t length) {
+  return (name[0] * 3 + name[1] + (int(length) << 3)) & 31;
+}
+
+static constexpr int suit_hash(const char *name, size_t length) {
+  return (name[0] + name[1] + int(length)) & 7;
+}
 
+static constexpr size_t name_length(const char *name) {
+  size_t length = 0;
+  while (name[length] != '\0') {
+    ++length;
+  }
+  return length;
+}
 
+// Rank or suit of each hash, or -1 where no name hashes
+template <int SIZE>
+struct NameTable {
+  int8_t index[SIZE] = {};
 
-//EFFECTS Initializes Card to the Two of Spades
-Card::Card() : rank(TWO), suit(SPADES) {}
+  template <int COUNT>
+  constexpr NameTable(const char *const (&names)[COUNT],
+                      int (*hash)(const char *, size_t)) {
+    for (int i = 0; i < SIZE; ++i) {
+      index[i] = -1;
+    }
+    for (int i = 0; i < COUNT; ++i) {
+      index[hash(names[i], name_length(names[i]))] = static_cast<int8_t>(i);
+    }
+  }
+};
 
-//EFFECTS Initializes Card to specified rank and suit
-Card::Card(Rank rank_in, Suit suit_in) : rank(rank_in), suit(suit_in){}
+static constexpr NameTable<32> RANK_TABLE(RANK_NAMES, rank_hash);
+static constexpr NameTable<8> SUIT_TABLE(SUIT_NAMES, suit_hash);
 
-  //EFFECTS Returns the rank
-Rank Card::get_rank() const{
-  return rank;
+// EFFECTS: Returns true if the length characters at name are exactly
+//          expected
+static bool same_name(const char *name, size_t length, const char *expected) {
+  for (size_t i = 0; i < length; ++i) {
+    if (name[i] != expected[i]) {
+      return false;
+    }
+  }
+  return expected[length] == '\0';
 }
 
-//EFFECTS Returns the suit.  Does not consider trump.
-Suit Card::get_suit() const{
-  return suit;
+bool Rank_parse(const char *name, size_t length, Rank &rank) {
+  if (length < 3) {
+    return false;
+  }
+  int r = RANK_TABLE.index[rank_hash(name, length)];
+  if (r == -1 || !same_name(name, length, RANK_NAMES[r])) {
+    return false;
+  }
+  rank = static_cast<Rank>(r);
+  return true;
+}
+
+bool Suit_parse(const char *name, size_t length, Suit &suit) {
+  if (length < 5) {
+    return false;
+  }
+  int s = SUIT_TABLE.index[suit_hash(name, length)];
+  if (s == -1 || !same_name(name, length, SUIT_NAMES[s])) {
+    return false;
+  }
+  suit = static_cast<Suit>(s);
+  return true;
 }
 
+
+
+
 //EFFECTS Returns the suit
 //HINT: the left bower is the trump suit!
 Suit Card::get_suit(Suit trump) const{
   if (is_left_bower(trump)) {
     return trump;
   }
-  return suit;
+  return get_suit();
 }
 
 //EFFECTS Returns true if card is a face card (Jack, Queen, King or Ace)
 bool Card::is_face_or_ace() const{
    
-  return rank >= JACK;    
+  return get_rank() >= JACK;    
 }
 
 //EFFECTS Returns true if card is the Jack of the trump suit
 bool Card::is_right_bower(Suit trump) const{
-  if (rank == JACK) {
-    if (suit == trump) {
+  if (get_rank() == JACK) {
+    if (get_suit() == trump) {
       return true;
     }
   }
@@ -141,8 +217,8 @@ bool Card::is_right_bower(Suit trump) const{
 
 //EFFECTS Returns true if card is the Jack of the next suit
 bool Card::is_left_bower(Suit trump) const {
-  if (rank == JACK) {
-    if (suit == Suit_next(trump)) {
+  if (get_rank() == JACK) {
+    if (get_suit() == Suit_next(trump)) {
       return true;
     }
   } 
@@ -157,7 +233,7 @@ bool Card::is_trump(Suit trump) const {
     return true;
   }
 
-  return (suit == trump);
+  return (get_suit() == trump);
 }
 
 
@@ -169,150 +245,179 @@ std::ostream & operator<<(std::ostream &os, const Card &card){
 
 //EFFECTS Reads a Card from a stream in the format "Two of Spades"
 //NOTE The Card class declares this operator>> "friend" function,
-//     which means it is allowed to access card.rank and card.suit.
+//     which means it is allowed to access card.index.
 std::istream & operator>>(std::istream &is, Card &card){
-  string rank;
-  string suit;
-  string temp; 
-
-  is >> rank >> temp >> suit;
-
-  card.rank = string_to_rank(rank);
-  card.suit = string_to_suit(suit);
-  
+  // Long enough for any name; longer words are cut and then do not match
+  char rank[8];
+  char of[4];
+  char suit[12];
+
+  if (is >> setw(sizeof(rank)) >> rank >> setw(sizeof(of)) >> of
+         >> setw(sizeof(suit)) >> suit) {
+    Rank card_rank = TWO;
+    Suit card_suit = SPADES;
+    bool valid = Rank_parse(rank, strlen(rank), card_rank) &&
+                 strcmp(of, "of") == 0 &&
+                 Suit_parse(suit, strlen(suit), card_suit);
+    if (valid) {
+      card.index = Card_index(Card(card_rank, card_suit));
+    } else {
+      // Input didn't match "Rank of Suit"
+      is.setstate(std::ios::failbit);
+    }
+  }
   return is;
 }
 
 //EFFECTS Returns true if lhs is lower value than rhs.
 //  Does not consider trump.
 bool operator<(const Card &lhs, const Card &rhs){
-  
-  if (lhs.get_rank() == rhs.get_rank()) {
-    return lhs.get_suit() < rhs.get_suit();
-  }
-
-  return lhs.get_rank() < rhs.get_rank();
+  // Index order is rank first, then suit
+  return Card_index(lhs) < Card_index(rhs);
 }
 
 //EFFECTS Returns true if lhs is lower value than rhs or the same card as rhs.
 //  Does not consider trump.
 bool operator<=(const Card &lhs, const Card &rhs){
-  if (lhs.get_rank() == rhs.get_rank()) {
-    return lhs.get_suit() <= rhs.get_suit();
-  }
-
-
-  return lhs.get_rank() <= rhs.get_rank();
+  return Card_index(lhs) <= Card_index(rhs);
 }
 //EFFECTS Returns true if lhs is higher value than rhs.
 //  Does not consider trump.
 bool operator>(const Card &lhs, const Card &rhs){
-  if (lhs.get_rank() == rhs.get_rank()) {
-    return lhs.get_suit() > rhs.get_suit();
-  }
-
-  return lhs.get_rank() > rhs.get_rank();
+  return Card_index(lhs) > Card_index(rhs);
 }
 
 //EFFECTS Returns true if lhs is higher value than rhs or the same card as rhs.
 //  Does not consider trump.
 bool operator>=(const Card &lhs, const Card &rhs){
-  if (lhs.get_rank() == rhs.get_rank()) {
-    return lhs.get_suit() >= rhs.get_suit();
-  }
-
-  return lhs.get_rank() >= rhs.get_rank();
+  return Card_index(lhs) >= Card_index(rhs);
 }
 
-//EFFECTS Returns true if lhs is same card as rhs.
-//  Does not consider trump.
-bool operator==(const Card &lhs, const Card &rhs){
-  return (lhs.get_rank() == rhs.get_rank() && lhs.get_suit() == rhs.get_suit());
-}
-
-//EFFECTS Returns true if lhs is not the same card as rhs.
-//  Does not consider trump.
-bool operator!=(const Card &lhs, const Card &rhs){
-  return !(lhs == rhs);
-}
-
-//EFFECTS returns the next suit, which is the suit of the same color
-Suit Suit_next(Suit suit){
-  if (suit == CLUBS) {
-    return SPADES;
-  } else if (suit == SPADES) {
-    return CLUBS;
-  } else if (suit == DIAMONDS){
-    return HEARTS;
-  } else {
-    return DIAMONDS;
-  } 
+// Builds CARD_STRENGTH. Non-trump cards off the suit led keep their
+// Card_index, so they compare as operator< does. Cards of the suit led
+// sit above them, trump above those, and the left and right bowers on top.
+static constexpr CardStrengthTable make_card_strength_table() {
+  CardStrengthTable table = {};
+  for (int trump = SPADES; trump <= DIAMONDS; ++trump) {
+    int next = trump ^ 2;
+    for (int led = SPADES; led <= DIAMONDS; ++led) {
+      for (int index = 0; index < NUM_CARD_INDICES; ++index) {
+        int rank = index / 4;
+        int suit = index % 4;
+        int strength = index;
+        if (rank == JACK && suit == trump) {
+          strength = 255;
+        } else if (rank == JACK && suit == next) {
+          strength = 254;
+        } else if (suit == trump) {
+          strength = 128 + index;
+        } else if (suit == led) {
+          strength = 64 + index;
+        }
+        table.strength[trump][led][index] = strength;
+      }
+    }
+  }
+  return table;
 }
 
+constexpr CardStrengthTable CARD_STRENGTH = make_card_strength_table();
 
 //EFFECTS Returns true if a is lower value than b.  Uses trump to determine
 // order, as described in the spec.
 bool Card_less(const Card &a, const Card &b, Suit trump){
-  
-  if (a.is_trump(trump) && b.is_trump(trump)) {
-    
-    if (a.is_right_bower(trump)) {
-      return false;  
-    } else if (b.is_right_bower(trump)){
-      return true;
-    } else if (a.is_left_bower(trump)) {
-      return false;
-    } else if (b.is_left_bower(trump)) {
-      return true;
-    } else {
-      return a < b;
-    }
-  }
-
-  if (a.is_trump(trump) && !b.is_trump(trump)) return false;
-  if (!a.is_trump(trump) && b.is_trump(trump)) return true;
-  return a < b; //no trumps
+  return Card_strength(a, trump, trump) < Card_strength(b, trump, trump);
 }
 
 //EFFECTS Returns true if a is lower value than b.  Uses both the trump suit
 //  and the suit led to determine order, as described in the spec.
 bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump){
-  
-  bool a_is_trump = a.is_trump(trump);
-  bool b_is_trump = b.is_trump(trump);
-
-  bool a_is_led = (a.get_suit(trump) == led_card.get_suit(trump));
-  bool b_is_led = (b.get_suit(trump) == led_card.get_suit(trump));
-
-  
-  if (a_is_trump && b_is_trump) {
-    return Card_less(a, b, trump);
-  }
-
-  if (a_is_trump && !b_is_trump) { 
-    return false;
-  }
+  Suit led = led_card.get_suit(trump);
+  return Card_strength(a, led, trump) < Card_strength(b, led, trump);
+}
 
-  if (!a_is_trump && b_is_trump) {
-    return true;
+//REQUIRES trick holds the cards of one trick in the order played, starting
+//  with the led card
+//EFFECTS Returns the position in trick of the card that takes the trick
+int Trick_winner(const Card trick[TRICK_SIZE], Suit trump) {
+  Suit led = trick[0].get_suit(trump);
+  int winner = 0;
+  int best = Card_strength(trick[0], led, trump);
+  for (int i = 1; i < TRICK_SIZE; ++i) {
+    int strength = Card_strength(trick[i], led, trump);
+    if (best < strength) {
+      best = strength;
+      winner = i;
+    }
   }
+  return winner;
+}
 
-  if (a_is_led && b_is_led) {
-    return a < b;
-  }
+#ifdef CARD_SSE2
+// EFFECTS: Copies the low byte of each 32-bit lane of x to the lane's other
+//          bytes. The rest of each lane must be zero.
+static inline __m128i broadcast_low_byte(__m128i x) {
+  x = _mm_or_si128(x, _mm_slli_epi32(x, 8));
+  return _mm_or_si128(x, _mm_slli_epi32(x, 16));
+}
 
-  if (a_is_led && !b_is_led) {
-    return false;
+// Resolves four tricks, one per 32-bit lane with the led card in the low
+// byte, by computing each card's CARD_STRENGTH entry from its index: bit 7
+// for trump, bit 6 for the suit led, and the bowers raised to 255 and 254.
+// Returns the movemask of the cards that equal the best of their trick.
+static inline int trick_winner_mask(__m128i cards, __m128i trump) {
+  const __m128i low_byte = _mm_set1_epi32(0xff);
+  const __m128i jack = _mm_set1_epi8(JACK * 4);
+  __m128i suit = _mm_and_si128(cards, _mm_set1_epi8(3));
+  trump = broadcast_low_byte(trump);
+  __m128i right = _mm_cmpeq_epi8(cards, _mm_add_epi8(trump, jack));
+  __m128i next = _mm_xor_si128(trump, _mm_set1_epi8(2));
+  __m128i left = _mm_cmpeq_epi8(cards, _mm_add_epi8(next, jack));
+
+  // The suit led counts the left bower as trump
+  __m128i led = _mm_or_si128(_mm_and_si128(left, trump),
+                             _mm_andnot_si128(left, suit));
+  led = broadcast_low_byte(_mm_and_si128(led, low_byte));
+
+  __m128i is_trump = _mm_cmpeq_epi8(suit, trump);
+  __m128i is_led = _mm_andnot_si128(is_trump, _mm_cmpeq_epi8(suit, led));
+  __m128i strength = _mm_or_si128(
+    cards, _mm_or_si128(_mm_and_si128(is_trump, _mm_set1_epi8(-128)),
+                        _mm_and_si128(is_led, _mm_set1_epi8(64))));
+  __m128i bowers = _mm_or_si128(right, _mm_and_si128(left, _mm_set1_epi8(-2)));
+  strength = _mm_max_epu8(strength, bowers);
+
+  __m128i best = _mm_max_epu8(strength, _mm_srli_epi32(strength, 8));
+  best = _mm_max_epu8(best, _mm_srli_epi32(best, 16));
+  best = broadcast_low_byte(_mm_and_si128(best, low_byte));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(strength, best));
+}
+#endif
+
+void Trick_winners(const Card *tricks, const Suit *trumps, int count,
+                   int *winners) {
+  int n = 0;
+#ifdef CARD_SSE2
+  // Cards are single bytes, so four tricks fill a register, and each
+  // trump fills the 32-bit lane of its trick
+  static_assert(sizeof(Suit) == 4, "four trumps fill a register");
+  for (; n + 4 <= count; n += 4) {
+    __m128i cards = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(tricks + n * TRICK_SIZE));
+    __m128i trump = _mm_loadu_si128(
+      reinterpret_cast<const __m128i *>(trumps + n));
+    int mask = trick_winner_mask(cards, trump);
+    // The first card that equals the best, as Trick_winner keeps the first
+    for (int k = 0; k < 4; ++k) {
+      winners[n + k] = __builtin_ctz(mask >> (k * TRICK_SIZE));
+    }
   }
-
-  if (!a_is_led && b_is_led) {
-    return true;
+#endif
+  for (; n < count; ++n) {
+    winners[n] = Trick_winner(tricks + n * TRICK_SIZE, trumps[n]);
   }
-
-  return a < b;
 }
 
-
 // NOTE: We HIGHLY recommend you check out the operator overloading
 // tutorial in the project spec before implementing
 // the following operator overload functions:
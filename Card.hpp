@@ -9,6 +9,7 @@
  * 2014-12-21
  */
 
+#include <cstddef>
 #include <iostream>
 
 // Represent a Card's Rank.
@@ -46,6 +47,15 @@ enum Rank {
 //EFFECTS returns the Rank corresponding to str, for example "Two" -> TWO
 Rank string_to_rank(const std::string &str);
 
+//EFFECTS Returns the name of rank, for example "Two"
+const char * Rank_name(Rank rank);
+
+//MODIFIES rank
+//EFFECTS If the length characters at name are exactly the name of a rank,
+//  sets rank to it and returns true. Otherwise returns false. Never
+//  allocates.
+bool Rank_parse(const char *name, size_t length, Rank &rank);
+
 //EFFECTS Prints Rank to stream, for example "Two"
 std::ostream & operator<<(std::ostream &os, Rank rank);
 
@@ -65,6 +75,15 @@ enum Suit {
 //EFFECTS returns the Suit corresponding to str, for example "Clubs" -> CLUBS
 Suit string_to_suit(const std::string &str);
 
+//EFFECTS Returns the name of suit, for example "Spades"
+const char * Suit_name(Suit suit);
+
+//MODIFIES suit
+//EFFECTS If the length characters at name are exactly the name of a suit,
+//  sets suit to it and returns true. Otherwise returns false. Never
+//  allocates.
+bool Suit_parse(const char *name, size_t length, Suit &suit);
+
 //EFFECTS Prints Suit to stream, for example "Spades"
 std::ostream & operator<<(std::ostream &os, Suit suit);
 
@@ -106,20 +125,57 @@ public:
   bool is_trump(Suit trump) const;
 
 private:
-  Rank rank;
-  Suit suit;
+  // The rank and suit packed into one byte as rank * 4 + suit, so that a
+  // pack, a hand or a recorded trick takes one byte per card
+  unsigned char index;
 
   // This "friend declaration" allows the implementation of operator>>
   // to access private member variables of the Card class.
   friend std::istream & operator>>(std::istream &is, Card &card);
+
+  // Card_index returns the packed byte as it is
+  friend int Card_index(const Card &c);
 };
 
+static_assert(sizeof(Card) == 1, "a Card is packed into one byte");
+
+// The constructors and accessors are defined here so that table lookups
+// keyed on a card, and strategies built from them, can be inlined.
+inline Card::Card() : index(TWO * 4 + SPADES) {}
+
+inline Card::Card(Rank rank_in, Suit suit_in) :
+  index(static_cast<unsigned char>(rank_in * 4 + suit_in)) {}
+
+inline Rank Card::get_rank() const {
+  return static_cast<Rank>(index >> 2);
+}
+
+inline Suit Card::get_suit() const {
+  return static_cast<Suit>(index & 3);
+}
+
+// Number of entries in a table indexed by Card_index
+const int NUM_CARD_INDICES = 52;
+
+//EFFECTS Returns a unique index from 0 to 51 for c, rank * 4 + suit.
+//  Index order is the same as operator<.
+inline int Card_index(const Card &c) {
+  return c.index;
+}
+
+//REQUIRES 0 <= index < NUM_CARD_INDICES
+//EFFECTS Returns the card whose Card_index is index
+inline Card Card_from_index(int index) {
+  return Card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+}
+
 //EFFECTS Prints Card to stream, for example "Two of Spades"
 std::ostream & operator<<(std::ostream &os, const Card &card);
 
-//EFFECTS Reads a Card from a stream in the format "Two of Spades"
+//EFFECTS Reads a Card from a stream in the format "Two of Spades". If
+//  the input does not match, sets failbit and leaves card unchanged.
 //NOTE The Card class declares this operator>> "friend" function,
-//     which means it is allowed to access card.rank and card.suit.
+//     which means it is allowed to access card.index.
 std::istream & operator>>(std::istream &is, Card &card);
 
 //EFFECTS Returns true if lhs is lower value than rhs.
@@ -140,14 +196,22 @@ bool operator>=(const Card &lhs, const Card &rhs);
 
 //EFFECTS Returns true if lhs is same card as rhs.
 //  Does not consider trump.
-bool operator==(const Card &lhs, const Card &rhs);
+inline bool operator==(const Card &lhs, const Card &rhs) {
+  return Card_index(lhs) == Card_index(rhs);
+}
 
 //EFFECTS Returns true if lhs is not the same card as rhs.
 //  Does not consider trump.
-bool operator!=(const Card &lhs, const Card &rhs);
+inline bool operator!=(const Card &lhs, const Card &rhs) {
+  return !(lhs == rhs);
+}
 
 //EFFECTS returns the next suit, which is the suit of the same color
-Suit Suit_next(Suit suit);
+//  Defined here so that the CardSet masks built from it are inlined.
+inline Suit Suit_next(Suit suit) {
+  // SPADES (0) pairs with CLUBS (2), HEARTS (1) with DIAMONDS (3)
+  return static_cast<Suit>(suit ^ 2);
+}
 
 //EFFECTS Returns true if a is lower value than b.  Uses trump to determine
 // order, as described in the spec.
@@ -157,4 +221,37 @@ bool Card_less(const Card &a, const Card &b, Suit trump);
 //  and the suit led to determine order, as described in the spec.
 bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump);
 
+// The trump-relative strength of every card for each trump suit and
+// suit led, generated at compile time in Card.cpp. Indexed by
+// [trump][led suit][Card_index(card)].
+struct CardStrengthTable {
+  unsigned char strength[4][4][NUM_CARD_INDICES];
+};
+extern const CardStrengthTable CARD_STRENGTH;
+
+//EFFECTS Returns a number that orders cards the way Card_less does:
+//  Card_less(a, b, led_card, trump) is true exactly when the strength of a
+//  is less than the strength of b, with led = led_card.get_suit(trump).
+//  With led == trump it matches Card_less(a, b, trump).
+inline int Card_strength(const Card &c, Suit led, Suit trump) {
+  return CARD_STRENGTH.strength[trump][led][Card_index(c)];
+}
+
+// Number of cards in a trick
+const int TRICK_SIZE = 4;
+
+//REQUIRES trick holds the cards of one trick in the order played, starting
+//  with the led card
+//EFFECTS Returns the position in trick of the card that takes the trick
+int Trick_winner(const Card trick[TRICK_SIZE], Suit trump);
+
+//REQUIRES tricks holds count tricks one after another, TRICK_SIZE cards
+//  each, and trumps holds the trump suit of each
+//MODIFIES winners
+//EFFECTS Sets winners[n] to Trick_winner(tricks + n * TRICK_SIZE, trumps[n])
+//  for each trick. Where SSE2 is available, four tricks are resolved at
+//  once, with strengths computed in registers rather than looked up.
+void Trick_winners(const Card *tricks, const Suit *trumps, int count,
+                   int *winners);
+
 #endif // CARD_HPP
@@ -0,0 +1,210 @@
+#ifndef CARDSET_HPP
+#define CARDSET_HPP
+/* CardSet.hpp
+ *
+ * A set of distinct cards stored as one bit per card
+ */
+
+#include "Card.hpp"
+#include <cassert>
+#include <cstdint>
+
+// Each card is one bit of a 64-bit word, at position rank * 4 + suit. Bit
+// order is therefore the same as Card operator<, so the highest set bit is
+// the highest card when trump is ignored. Every rank from TWO to ACE has a
+// bit, not only the euchre ranks, so any Card can be stored.
+//
+// Adding, removing and finding the highest or lowest card are a few bit
+// operations and never allocate.
+class CardSet {
+public:
+  //EFFECTS Initializes an empty set
+  CardSet() : bits(0) {}
+
+  //EFFECTS Initializes a set from its bit representation
+  explicit CardSet(uint64_t bits_in) : bits(bits_in) {}
+
+  //EFFECTS Returns the bit for card c
+  static uint64_t bit(const Card &c) {
+    return uint64_t(1) << Card_index(c);
+  }
+
+  //EFFECTS Returns the bit representation of the set
+  uint64_t get_bits() const { return bits; }
+
+  //EFFECTS Returns true if the set has no cards
+  bool empty() const { return bits == 0; }
+
+  //EFFECTS Returns the number of cards in the set
+  int size() const { return __builtin_popcountll(bits); }
+
+  //EFFECTS Returns true if c is in the set
+  bool contains(const Card &c) const { return (bits & bit(c)) != 0; }
+
+  //REQUIRES c is not in the set
+  //EFFECTS Adds c to the set
+  void add(const Card &c) {
+    assert(!contains(c));
+    bits |= bit(c);
+  }
+
+  //REQUIRES c is in the set
+  //EFFECTS Removes c from the set
+  void remove(const Card &c) {
+    assert(contains(c));
+    bits &= ~bit(c);
+  }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the highest card.  Does not consider trump.
+  Card highest() const {
+    assert(!empty());
+    return card_at(63 - __builtin_clzll(bits));
+  }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the lowest card.  Does not consider trump.
+  Card lowest() const {
+    assert(!empty());
+    return card_at(__builtin_ctzll(bits));
+  }
+
+  CardSet operator&(CardSet other) const { return CardSet(bits & other.bits); }
+  CardSet operator|(CardSet other) const { return CardSet(bits | other.bits); }
+  CardSet operator~() const { return CardSet(~bits & ALL); }
+  bool operator==(CardSet other) const { return bits == other.bits; }
+  bool operator!=(CardSet other) const { return bits != other.bits; }
+
+  // Every card, Two through Ace in each suit
+  static constexpr uint64_t ALL = 0x000FFFFFFFFFFFFF;
+
+  // Every card of SPADES. Shift left by the suit for the other suits.
+  static constexpr uint64_t SPADES_BITS = 0x0001111111111111;
+
+  // Jacks, Queens, Kings and Aces
+  static constexpr uint64_t FACE_OR_ACE_BITS = 0x000FFFF000000000;
+
+  // The 24 cards of a euchre pack, Nines through Aces
+  static constexpr uint64_t EUCHRE_BITS = 0x000FFFFFF0000000;
+
+private:
+  uint64_t bits;
+
+  static Card card_at(int index) {
+    return Card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+  }
+};
+
+// A player's hand. Real deals never repeat a card, but hand-built hands
+// may, so each card keeps a count from 0 to 7. Bit i of the count lives in
+// planes[i]; adding and removing a card are a carry or borrow across the
+// three planes.
+class CardHand {
+public:
+  //EFFECTS Returns the distinct cards in the hand
+  CardSet cards() const { return planes[0] | planes[1] | planes[2]; }
+
+  //EFFECTS Returns the number of cards in subset, counting repeats
+  int count(CardSet subset) const {
+    return (planes[0] & subset).size() + 2 * (planes[1] & subset).size() +
+           4 * (planes[2] & subset).size();
+  }
+
+  //EFFECTS Returns the number of cards, counting repeats
+  int size() const { return count(CardSet(CardSet::ALL)); }
+
+  //EFFECTS Returns true if the hand has no cards
+  bool empty() const { return cards().empty(); }
+
+  //REQUIRES the hand holds fewer than seven copies of c
+  //EFFECTS Adds c to the hand
+  void add(const Card &c) {
+    CardSet bit(CardSet::bit(c));
+    assert(count(bit) < 7);
+    for (CardSet &plane : planes) {
+      plane = CardSet(plane.get_bits() ^ bit.get_bits());
+      if (plane.contains(c)) {
+        return;
+      }
+    }
+  }
+
+  //REQUIRES c is in the hand
+  //EFFECTS Removes one copy of c from the hand
+  void remove(const Card &c) {
+    CardSet bit(CardSet::bit(c));
+    assert(count(bit) > 0);
+    for (CardSet &plane : planes) {
+      plane = CardSet(plane.get_bits() ^ bit.get_bits());
+      if (!plane.contains(c)) {
+        return;
+      }
+    }
+  }
+
+private:
+  CardSet planes[3];
+};
+
+//EFFECTS Returns every card of suit.  Does not consider trump.
+inline CardSet CardSet_suit(Suit suit) {
+  return CardSet(CardSet::SPADES_BITS << suit);
+}
+
+//EFFECTS Returns every card that is trump: the trump suit and the left bower
+inline CardSet CardSet_trump(Suit trump) {
+  return CardSet(CardSet_suit(trump).get_bits() |
+                 CardSet::bit(Card(JACK, Suit_next(trump))));
+}
+
+//EFFECTS Returns every card whose suit is suit once trump is considered.
+//  The left bower belongs to the trump suit, not to its printed suit.
+inline CardSet CardSet_suit(Suit suit, Suit trump) {
+  if (suit == trump) {
+    return CardSet_trump(trump);
+  }
+  uint64_t bits = CardSet_suit(suit).get_bits();
+  if (suit == Suit_next(trump)) {
+    bits &= ~CardSet::bit(Card(JACK, suit));
+  }
+  return CardSet(bits);
+}
+
+//REQUIRES cards is not empty
+//EFFECTS Returns the highest card in cards, using trump to determine order
+//  as Card_less does
+inline Card CardSet_highest(CardSet cards, Suit trump) {
+  CardSet trumps = cards & CardSet_trump(trump);
+  if (trumps.empty()) {
+    return cards.highest();
+  }
+  Card right(JACK, trump);
+  Card left(JACK, Suit_next(trump));
+  if (trumps.contains(right)) {
+    return right;
+  }
+  if (trumps.contains(left)) {
+    return left;
+  }
+  return trumps.highest();
+}
+
+//REQUIRES cards is not empty
+//EFFECTS Returns the lowest card in cards, using trump to determine order
+//  as Card_less does
+inline Card CardSet_lowest(CardSet cards, Suit trump) {
+  CardSet trumps = cards & CardSet_trump(trump);
+  if (trumps != cards) {
+    return (cards & ~trumps).lowest();
+  }
+  CardSet bowers(CardSet::bit(Card(JACK, trump)) |
+                 CardSet::bit(Card(JACK, Suit_next(trump))));
+  CardSet low_trumps = trumps & ~bowers;
+  if (!low_trumps.empty()) {
+    return low_trumps.lowest();
+  }
+  Card left(JACK, Suit_next(trump));
+  return trumps.contains(left) ? left : Card(JACK, trump);
+}
+
+#endif // CARDSET_HPP
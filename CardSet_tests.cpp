@@ -0,0 +1,139 @@
+#include "CardSet.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// Every card that can be stored, Two through Ace of each suit
+static vector<Card> all_cards() {
+    vector<Card> cards;
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        for (int r = TWO; r <= ACE; ++r) {
+            cards.push_back(Card(static_cast<Rank>(r), static_cast<Suit>(s)));
+        }
+    }
+    return cards;
+}
+
+// A few hands with and without trump and bowers
+static vector<vector<Card>> sample_hands() {
+    return {
+        {Card(NINE, SPADES)},
+        {Card(JACK, CLUBS), Card(NINE, SPADES), Card(ACE, HEARTS)},
+        {Card(JACK, SPADES), Card(JACK, CLUBS), Card(TEN, SPADES)},
+        {Card(KING, HEARTS), Card(KING, DIAMONDS), Card(TWO, CLUBS)},
+        {Card(JACK, HEARTS), Card(JACK, DIAMONDS), Card(QUEEN, DIAMONDS),
+         Card(NINE, HEARTS), Card(ACE, CLUBS), Card(FIVE, SPADES)},
+    };
+}
+
+TEST(test_card_set_add_remove) {
+    CardSet set;
+    ASSERT_TRUE(set.empty());
+    set.add(Card(NINE, HEARTS));
+    set.add(Card(ACE, SPADES));
+    ASSERT_EQUAL(set.size(), 2);
+    ASSERT_TRUE(set.contains(Card(NINE, HEARTS)));
+    ASSERT_FALSE(set.contains(Card(NINE, SPADES)));
+
+    set.remove(Card(NINE, HEARTS));
+    ASSERT_EQUAL(set.size(), 1);
+    ASSERT_FALSE(set.contains(Card(NINE, HEARTS)));
+}
+
+// Highest and lowest without trump follow Card operator<
+TEST(test_card_set_highest_lowest) {
+    CardSet set;
+    set.add(Card(TEN, DIAMONDS));
+    set.add(Card(KING, SPADES));
+    set.add(Card(KING, HEARTS));
+    set.add(Card(TWO, CLUBS));
+    ASSERT_EQUAL(set.highest(), Card(KING, HEARTS));
+    ASSERT_EQUAL(set.lowest(), Card(TWO, CLUBS));
+}
+
+TEST(test_card_set_complement) {
+    CardSet none;
+    ASSERT_EQUAL((~none).size(), 52);
+    ASSERT_TRUE((~~none).empty());
+}
+
+// CardSet_suit(suit, trump) holds exactly the cards whose get_suit(trump)
+// is suit
+TEST(test_card_set_suit_matches_get_suit) {
+    for (int t = SPADES; t <= DIAMONDS; ++t) {
+        Suit trump = static_cast<Suit>(t);
+        for (int s = SPADES; s <= DIAMONDS; ++s) {
+            Suit suit = static_cast<Suit>(s);
+            CardSet set = CardSet_suit(suit, trump);
+            for (const Card &c : all_cards()) {
+                ASSERT_EQUAL(set.contains(c), c.get_suit(trump) == suit);
+            }
+        }
+        for (const Card &c : all_cards()) {
+            ASSERT_EQUAL(CardSet_trump(trump).contains(c), c.is_trump(trump));
+        }
+    }
+}
+
+// CardSet_highest and CardSet_lowest agree with a scan using Card_less
+TEST(test_card_set_trump_order_matches_card_less) {
+    for (const vector<Card> &hand : sample_hands()) {
+        CardSet set;
+        for (const Card &c : hand) {
+            set.add(c);
+        }
+        for (int t = SPADES; t <= DIAMONDS; ++t) {
+            Suit trump = static_cast<Suit>(t);
+            Card high = hand[0];
+            Card low = hand[0];
+            for (const Card &c : hand) {
+                if (Card_less(high, c, trump)) {
+                    high = c;
+                }
+                if (Card_less(c, low, trump)) {
+                    low = c;
+                }
+            }
+            ASSERT_EQUAL(CardSet_highest(set, trump), high);
+            ASSERT_EQUAL(CardSet_lowest(set, trump), low);
+        }
+    }
+}
+
+// A hand keeps a repeated card until both copies are removed
+TEST(test_card_hand_repeated_card) {
+    CardHand hand;
+    hand.add(Card(TEN, HEARTS));
+    hand.add(Card(NINE, HEARTS));
+    hand.add(Card(TEN, HEARTS));
+    ASSERT_EQUAL(hand.size(), 3);
+    ASSERT_EQUAL(hand.cards().size(), 2);
+
+    hand.remove(Card(TEN, HEARTS));
+    ASSERT_TRUE(hand.cards().contains(Card(TEN, HEARTS)));
+    hand.remove(Card(TEN, HEARTS));
+    ASSERT_FALSE(hand.cards().contains(Card(TEN, HEARTS)));
+    ASSERT_EQUAL(hand.size(), 1);
+}
+
+TEST(test_card_hand_count) {
+    CardHand hand;
+    for (int i = 0; i < 5; ++i) {
+        hand.add(Card(KING, CLUBS));
+    }
+    hand.add(Card(NINE, CLUBS));
+    ASSERT_EQUAL(hand.size(), 6);
+    ASSERT_EQUAL(hand.count(CardSet(CardSet::FACE_OR_ACE_BITS)), 5);
+    ASSERT_EQUAL(hand.count(CardSet_suit(CLUBS)), 6);
+    ASSERT_EQUAL(hand.count(CardSet_suit(SPADES)), 0);
+
+    for (int i = 0; i < 5; ++i) {
+        hand.remove(Card(KING, CLUBS));
+    }
+    ASSERT_EQUAL(hand.size(), 1);
+    ASSERT_EQUAL(hand.cards().lowest(), Card(NINE, CLUBS));
+}
+
+TEST_MAIN()
@@ -1,6 +1,8 @@
 #include "Card.hpp"
 #include "unit_test_framework.hpp"
+#include <cstring>
 #include <sstream>
+#include <vector>
 
 using namespace std;
 
@@ -127,6 +129,52 @@ TEST(test_operator_input_output) {
     ASSERT_EQUAL(c4, c2);
 }
 
+//tests that malformed cards fail the stream and leave the card alone
+TEST(test_operator_input_malformed) {
+    const char *inputs[] = {"Jack of Spadez", "Jock of Spades",
+                            "Jack on Spades", "Jack of"};
+    for (const char *input : inputs) {
+        Card card(NINE, HEARTS);
+        istringstream is(input);
+        is >> card;
+        ASSERT_TRUE(is.fail());
+        ASSERT_EQUAL(card, Card(NINE, HEARTS));
+    }
+}
+
+//tests parsing names without allocating, including near misses
+TEST(test_rank_suit_parse) {
+    for (int r = TWO; r <= ACE; ++r) {
+        const char *name = Rank_name(static_cast<Rank>(r));
+        Rank rank = TWO;
+        ASSERT_TRUE(Rank_parse(name, strlen(name), rank));
+        ASSERT_EQUAL(rank, r);
+    }
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        const char *name = Suit_name(static_cast<Suit>(s));
+        Suit suit = SPADES;
+        ASSERT_TRUE(Suit_parse(name, strlen(name), suit));
+        ASSERT_EQUAL(suit, s);
+    }
+
+    Rank rank = KING;
+    for (const char *bad : {"", "T", "Tw", "Twos", "ten", "Tex", "Ac",
+                            "Queens", "Spades", "Nien"}) {
+        ASSERT_FALSE(Rank_parse(bad, strlen(bad), rank));
+    }
+    ASSERT_EQUAL(rank, KING);
+    // a name followed by more text only matches for the given length
+    ASSERT_TRUE(Rank_parse("Sevenish", 5, rank));
+    ASSERT_EQUAL(rank, SEVEN);
+
+    Suit suit = CLUBS;
+    for (const char *bad : {"", "Club", "Clubz", "Diamond", "spades",
+                            "Heartss", "Nine"}) {
+        ASSERT_FALSE(Suit_parse(bad, strlen(bad), suit));
+    }
+    ASSERT_EQUAL(suit, CLUBS);
+}
+
 //tests all suit next possibilities
 TEST(test_suit_next) {
     ASSERT_EQUAL(Suit_next(CLUBS), SPADES);
@@ -206,6 +254,135 @@ TEST(test_Card_less_yes_led) {
     ASSERT_EQUAL(Card_less(ace_non_anything, jack_non_anything, led_card, SPADES), false);
 }
 
+// Card_less written out rule by rule, to check the strength table against
+static bool reference_less(const Card &a, const Card &b, Suit led, Suit trump) {
+    if (a.is_trump(trump) != b.is_trump(trump)) {
+        return b.is_trump(trump);
+    }
+    if (a.is_trump(trump)) {
+        if (a.is_right_bower(trump) || b.is_right_bower(trump)) {
+            return b.is_right_bower(trump) && !a.is_right_bower(trump);
+        }
+        if (a.is_left_bower(trump) || b.is_left_bower(trump)) {
+            return b.is_left_bower(trump) && !a.is_left_bower(trump);
+        }
+        return a < b;
+    }
+    bool a_is_led = a.get_suit() == led;
+    bool b_is_led = b.get_suit() == led;
+    if (a_is_led != b_is_led) {
+        return b_is_led;
+    }
+    return a < b;
+}
+
+//tests both Card_less overloads on every pair of cards, trump and led card
+TEST(test_Card_less_exhaustive) {
+    vector<Card> cards;
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        for (int r = TWO; r <= ACE; ++r) {
+            cards.push_back(Card(static_cast<Rank>(r), static_cast<Suit>(s)));
+        }
+    }
+
+    for (int t = SPADES; t <= DIAMONDS; ++t) {
+        Suit trump = static_cast<Suit>(t);
+        for (const Card &a : cards) {
+            for (const Card &b : cards) {
+                ASSERT_EQUAL(Card_less(a, b, trump),
+                             reference_less(a, b, trump, trump));
+                for (const Card &led_card : cards) {
+                    Suit led = led_card.get_suit(trump);
+                    ASSERT_EQUAL(Card_less(a, b, led_card, trump),
+                                 reference_less(a, b, led, trump));
+                }
+            }
+        }
+    }
+}
+
+//tests that every card packs into one byte and unpacks to itself, and
+//that the packed order is the order of operator<
+TEST(test_card_index_round_trip) {
+    ASSERT_EQUAL(sizeof(Card), size_t(1));
+    for (int i = 0; i < NUM_CARD_INDICES; ++i) {
+        Card c = Card_from_index(i);
+        ASSERT_EQUAL(Card_index(c), i);
+        ASSERT_EQUAL(Card_index(c), c.get_rank() * 4 + c.get_suit());
+        if (i > 0) {
+            ASSERT_TRUE(Card_from_index(i - 1) < c);
+        }
+    }
+}
+
+// The winner of trick as Game::play_hand once found it, one Card_less at
+// a time
+static int reference_winner(const Card trick[TRICK_SIZE], Suit trump) {
+    int winner = 0;
+    for (int i = 1; i < TRICK_SIZE; ++i) {
+        if (Card_less(trick[winner], trick[i], trick[0], trump)) {
+            winner = i;
+        }
+    }
+    return winner;
+}
 
+//tests Trick_winners against Card_less on every trick of four euchre
+//cards, repeats included, for every trump. Each batch is split so that
+//both the vector loop and the loop for the tricks left over see every
+//kind of trick.
+TEST(test_trick_winners_exhaustive) {
+    vector<Card> deck;
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        for (int r = NINE; r <= ACE; ++r) {
+            deck.push_back(Card(static_cast<Rank>(r), static_cast<Suit>(s)));
+        }
+    }
+    const int deck_size = deck.size();
+    const int per_batch = deck_size * deck_size;
+    vector<Card> tricks(per_batch * TRICK_SIZE);
+    vector<Suit> trumps(per_batch);
+    vector<int> winners(per_batch);
+    for (int t = SPADES; t <= DIAMONDS; ++t) {
+        Suit trump = static_cast<Suit>(t);
+        trumps.assign(per_batch, trump);
+        for (int first = 0; first < per_batch; ++first) {
+            for (int rest = 0; rest < per_batch; ++rest) {
+                Card *trick = &tricks[rest * TRICK_SIZE];
+                trick[0] = deck[first / deck_size];
+                trick[1] = deck[first % deck_size];
+                trick[2] = deck[rest / deck_size];
+                trick[3] = deck[rest % deck_size];
+            }
+            int split = per_batch - 1 - first % 4;
+            Trick_winners(tricks.data(), trumps.data(), split, winners.data());
+            Trick_winners(&tricks[split * TRICK_SIZE], &trumps[split],
+                          per_batch - split, &winners[split]);
+            for (int n = 0; n < per_batch; ++n) {
+                ASSERT_EQUAL(winners[n],
+                             reference_winner(&tricks[n * TRICK_SIZE], trump));
+            }
+        }
+    }
+}
+
+// Tricks in one batch may each have their own trump
+TEST(test_trick_winners_mixed_trump) {
+    const Card trick[TRICK_SIZE] = {Card(NINE, HEARTS), Card(JACK, DIAMONDS),
+                                    Card(ACE, HEARTS), Card(TWO, SPADES)};
+    vector<Card> tricks;
+    vector<Suit> trumps;
+    for (int n = 0; n < 9; ++n) {
+        tricks.insert(tricks.end(), trick, trick + TRICK_SIZE);
+        trumps.push_back(static_cast<Suit>(n % 4));
+    }
+    vector<int> winners(trumps.size());
+    Trick_winners(tricks.data(), trumps.data(), trumps.size(), winners.data());
+    // Spades, hearts, clubs and diamonds trump, then again
+    const int expected[] = {3, 1, 2, 1, 3, 1, 2, 1, 3};
+    for (size_t n = 0; n < winners.size(); ++n) {
+        ASSERT_EQUAL(winners[n], expected[n]);
+    }
+}
 
 TEST_MAIN()
\ No newline at end of file
@@ -0,0 +1,228 @@
+#include "Deal.hpp"
+#include <array>
+#include <cassert>
+
+using namespace std;
+
+static const int HAND_SIZE = Player::MAX_HAND_SIZE;
+
+// Euchre cards are numbered 0 to 23 by position, Card_index - FIRST_BIT
+static const int FIRST_BIT = __builtin_ctzll(CardSet::EUCHRE_BITS);
+static const int NUM_CARDS = Pack::PACK_SIZE;
+
+// Binomial coefficients n choose k for every n up to NUM_CARDS
+struct BinomialTable {
+  uint64_t choose[NUM_CARDS + 1][HAND_SIZE + 1] = {};
+
+  constexpr BinomialTable() {
+    for (int n = 0; n <= NUM_CARDS; ++n) {
+      choose[n][0] = 1;
+      for (int k = 1; k <= HAND_SIZE && k <= n; ++k) {
+        choose[n][k] = choose[n - 1][k - 1] + (k < n ? choose[n - 1][k] : 0);
+      }
+    }
+  }
+};
+
+static constexpr BinomialTable BINOMIAL;
+
+// Number of choices for each hand, then the upcard
+static constexpr uint64_t HAND_CHOICES[4] = {
+  BINOMIAL.choose[24][5], BINOMIAL.choose[19][5], BINOMIAL.choose[14][5],
+  BINOMIAL.choose[9][5]
+};
+static const int UPCARD_CHOICES = 4;
+
+static_assert(HAND_CHOICES[0] == NUM_HANDS,
+              "NUM_HANDS does not match the binomial coefficients");
+static_assert(HAND_CHOICES[0] * HAND_CHOICES[1] * HAND_CHOICES[2] *
+              HAND_CHOICES[3] * UPCARD_CHOICES == NUM_DEALS,
+              "NUM_DEALS does not match the binomial coefficients");
+
+// EFFECTS: Returns the positions of the euchre cards in cards
+static uint32_t positions(CardSet cards) {
+  return static_cast<uint32_t>(cards.get_bits() >> FIRST_BIT);
+}
+
+// EFFECTS: Returns the cards at positions
+static CardSet cards_at(uint32_t positions) {
+  return CardSet(uint64_t(positions) << FIRST_BIT);
+}
+
+// REQUIRES: positions has more than n bits set
+// EFFECTS: Returns the bit of the nth lowest position, counting from 0
+static uint32_t nth_position(uint32_t positions, int n) {
+  for (int i = 0; i < n; ++i) {
+    positions &= positions - 1;
+  }
+  return positions & -positions;
+}
+
+// REQUIRES: hand is HAND_SIZE of the positions in remaining
+// EFFECTS: Returns the number of hand among the HAND_SIZE subsets of
+//          remaining in the combinatorial number system
+static uint64_t rank_hand(uint32_t hand, uint32_t remaining) {
+  uint64_t rank = 0;
+  for (int k = 1; k <= HAND_SIZE; ++k) {
+    uint32_t bit = hand & -hand;
+    hand ^= bit;
+    int below = __builtin_popcount(remaining & (bit - 1));
+    rank += BINOMIAL.choose[below][k];
+  }
+  return rank;
+}
+
+// REQUIRES: rank < BINOMIAL.choose[popcount(remaining)][HAND_SIZE]
+// EFFECTS: Returns the hand numbered rank among the subsets of remaining,
+//          undoing rank_hand
+static uint32_t unrank_hand(uint64_t rank, uint32_t remaining) {
+  uint32_t hand = 0;
+  int below = __builtin_popcount(remaining);
+  for (int k = HAND_SIZE; k >= 1; --k) {
+    do {
+      --below;
+    } while (BINOMIAL.choose[below][k] > rank);
+    rank -= BINOMIAL.choose[below][k];
+    hand |= nth_position(remaining, below);
+  }
+  return hand;
+}
+
+int Hand_rank(CardSet hand) {
+  assert(hand.size() == HAND_SIZE);
+  assert((hand & CardSet(CardSet::EUCHRE_BITS)) == hand);
+  // Among every euchre card, a card's position is the number below it
+  uint32_t cards = positions(hand);
+  uint64_t rank = 0;
+  for (int k = 1; k <= HAND_SIZE; ++k) {
+    rank += BINOMIAL.choose[__builtin_ctz(cards)][k];
+    cards &= cards - 1;
+  }
+  return static_cast<int>(rank);
+}
+
+CardSet Hand_unrank(int index) {
+  assert(0 <= index && index < NUM_HANDS);
+  return cards_at(unrank_hand(index,
+                              positions(CardSet(CardSet::EUCHRE_BITS))));
+}
+
+bool Deal_valid(const Deal &deal) {
+  const CardSet euchre(CardSet::EUCHRE_BITS);
+  CardSet seen;
+  for (const CardSet &hand : deal.hands) {
+    if (hand.size() != HAND_SIZE || (hand & euchre) != hand ||
+        !(hand & seen).empty()) {
+      return false;
+    }
+    seen = seen | hand;
+  }
+  if (deal.kitty.size() != NUM_CARDS - 4 * HAND_SIZE - 1 ||
+      !(deal.kitty & seen).empty() || seen.contains(deal.upcard) ||
+      deal.kitty.contains(deal.upcard)) {
+    return false;
+  }
+  seen = seen | deal.kitty | CardSet(CardSet::bit(deal.upcard));
+  return seen == euchre;
+}
+
+uint64_t Deal_rank(const Deal &deal) {
+  assert(Deal_valid(deal));
+  uint32_t remaining = positions(CardSet(CardSet::EUCHRE_BITS));
+  uint64_t index = 0;
+  for (int seat = 0; seat < 4; ++seat) {
+    uint32_t hand = positions(deal.hands[seat]);
+    index = index * HAND_CHOICES[seat] + rank_hand(hand, remaining);
+    remaining &= ~hand;
+  }
+  uint32_t upcard = positions(CardSet(CardSet::bit(deal.upcard)));
+  return index * UPCARD_CHOICES +
+         __builtin_popcount(remaining & (upcard - 1));
+}
+
+Deal Deal_unrank(uint64_t index) {
+  assert(index < NUM_DEALS);
+  uint64_t digits[5];
+  digits[4] = index % UPCARD_CHOICES;
+  index /= UPCARD_CHOICES;
+  for (int seat = 3; seat >= 0; --seat) {
+    digits[seat] = index % HAND_CHOICES[seat];
+    index /= HAND_CHOICES[seat];
+  }
+
+  Deal deal;
+  uint32_t remaining = positions(CardSet(CardSet::EUCHRE_BITS));
+  for (int seat = 0; seat < 4; ++seat) {
+    uint32_t hand = unrank_hand(digits[seat], remaining);
+    deal.hands[seat] = cards_at(hand);
+    remaining &= ~hand;
+  }
+  uint32_t upcard = nth_position(remaining, static_cast<int>(digits[4]));
+  deal.upcard = cards_at(upcard).lowest();
+  deal.kitty = cards_at(remaining & ~upcard);
+  return deal;
+}
+
+Pack Deal_pack(const Deal &deal, int dealer) {
+  assert(Deal_valid(deal));
+  assert(dealer >= 0 && dealer < 4);
+  array<Card, Pack::PACK_SIZE> cards;
+  CardSet hands[4] = {deal.hands[0], deal.hands[1], deal.hands[2],
+                      deal.hands[3]};
+  int next = 0;
+  for (int batch = 0; batch < 8; ++batch) {
+    CardSet &hand = hands[(dealer + 1 + batch) % 4];
+    for (int j = 0; j < DEAL_BATCHES[batch]; ++j) {
+      cards[next] = hand.lowest();
+      hand.remove(cards[next++]);
+    }
+  }
+  cards[next++] = deal.upcard;
+  for (CardSet kitty = deal.kitty; !kitty.empty(); ) {
+    cards[next] = kitty.lowest();
+    kitty.remove(cards[next++]);
+  }
+  return Pack(cards);
+}
+
+Deal Deal_canonical(const Deal &deal) {
+  assert(Deal_valid(deal));
+  const CardSet cards[5] = {deal.hands[0], deal.hands[1], deal.hands[2],
+                            deal.hands[3], deal.kitty};
+  SuitMap map = SuitMap_canonical(cards, 5, deal.upcard.get_suit());
+  Deal canonical;
+  for (int seat = 0; seat < 4; ++seat) {
+    canonical.hands[seat] = map(deal.hands[seat]);
+  }
+  canonical.upcard = map(deal.upcard);
+  canonical.kitty = map(deal.kitty);
+  return canonical;
+}
+
+DealIterator::DealIterator(uint64_t first, uint64_t stride) :
+  index(first), stride(stride) {
+  assert(stride >= 1);
+  if (!done()) {
+    deal = Deal_unrank(index);
+  }
+}
+
+DealIterator & DealIterator::operator++() {
+  assert(!done());
+  index = (NUM_DEALS - index <= stride) ? NUM_DEALS : index + stride;
+  if (done()) {
+    return *this;
+  }
+  if (stride == 1 && index % UPCARD_CHOICES != 0) {
+    // Only the upcard changes: it moves up to the lowest card of the kitty
+    // above it, and the old upcard joins the kitty
+    CardSet rest = deal.kitty | CardSet(CardSet::bit(deal.upcard));
+    uint32_t upcard = nth_position(positions(rest),
+                                   static_cast<int>(index % UPCARD_CHOICES));
+    deal.upcard = cards_at(upcard).lowest();
+    deal.kitty = cards_at(positions(rest) & ~upcard);
+  } else {
+    deal = Deal_unrank(index);
+  }
+  return *this;
+}
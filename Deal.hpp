@@ -0,0 +1,103 @@
+#ifndef DEAL_HPP
+#define DEAL_HPP
+/* Deal.hpp
+ *
+ * Numbering of every deal of a euchre pack
+ */
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "SuitMap.hpp"
+#include <cstdint>
+
+// Cards given to each player in turn, starting left of the dealer: two
+// times around the table, in batches of three and two
+const int DEAL_BATCHES[8] = {3, 2, 3, 2, 2, 3, 2, 3};
+
+// Number of distinct hands of five euchre cards, 24C5
+const int NUM_HANDS = 42504;
+
+//REQUIRES hand is five euchre cards
+//EFFECTS Returns the number of hand among every hand, from 0 to
+//  NUM_HANDS - 1, in the combinatorial number system
+int Hand_rank(CardSet hand);
+
+//REQUIRES 0 <= index < NUM_HANDS
+//EFFECTS Returns the hand numbered index, so Hand_rank(Hand_unrank(i)) == i
+CardSet Hand_unrank(int index);
+
+// One way of dealing the 24 cards of a euchre pack: five cards to each
+// seat, the upcard, and three cards left in the kitty
+struct Deal {
+  CardSet hands[4];
+  Card upcard;
+  CardSet kitty;
+};
+
+// Number of distinct deals, 24C5 * 19C5 * 14C5 * 9C5 * 4
+const uint64_t NUM_DEALS = 498688594500096;
+
+//EFFECTS Returns true if deal splits the 24 euchre cards into four hands
+//  of five, an upcard and a kitty of three
+bool Deal_valid(const Deal &deal);
+
+//REQUIRES Deal_valid(deal)
+//EFFECTS Returns the number of deal, from 0 to NUM_DEALS - 1. Each hand
+//  is numbered among the cards the hands before it leave, with the
+//  combinatorial number system, and the upcard among the last four cards.
+//  Numbers are ordered by hands[0] first and the upcard last.
+uint64_t Deal_rank(const Deal &deal);
+
+//REQUIRES index < NUM_DEALS
+//EFFECTS Returns the deal numbered index, so Deal_rank(Deal_unrank(i)) == i
+Deal Deal_unrank(uint64_t index);
+
+//REQUIRES Deal_valid(deal) and dealer is from 0 to 3
+//EFFECTS Returns a pack that deals deal when Game deals it from dealer's
+//  seat: hands[seat] to each seat, then the upcard. Each hand is dealt in
+//  increasing card order.
+Pack Deal_pack(const Deal &deal, int dealer);
+
+//REQUIRES Deal_valid(deal)
+//EFFECTS Returns deal relabelled by SuitMap_canonical relative to the
+//  upcard suit, over the hands in seat order then the kitty. The upcard
+//  becomes a SPADE. Deals that differ only by a relabelling of suits that
+//  keeps each suit paired with Suit_next have the same canonical deal.
+Deal Deal_canonical(const Deal &deal);
+
+// Walks deals in order of their number, optionally skipping ahead by a
+// stride. Deals first, first + stride, first + 2 * stride, ... so n
+// iterators with strides of n and firsts 0 to n - 1 split every deal
+// between n workers, without storing any of them.
+//
+// A stride of 1 moves the upcard through the last four cards before
+// unranking again, so consecutive deals are cheap.
+class DealIterator {
+public:
+  // REQUIRES: stride >= 1
+  // EFFECTS: Starts at the deal numbered first
+  explicit DealIterator(uint64_t first = 0, uint64_t stride = 1);
+
+  // EFFECTS: Returns true once every deal has been visited
+  bool done() const { return index >= NUM_DEALS; }
+
+  // EFFECTS: Returns the number of the current deal
+  uint64_t get_index() const { return index; }
+
+  // REQUIRES: !done()
+  const Deal & operator*() const { return deal; }
+  const Deal * operator->() const { return &deal; }
+
+  // REQUIRES: !done()
+  // EFFECTS: Moves to the next deal
+  DealIterator & operator++();
+
+private:
+  uint64_t index;
+  uint64_t stride;
+  Deal deal;
+};
+
+#endif // DEAL_HPP
@@ -0,0 +1,185 @@
+#include "Deal.hpp"
+#include "Game.hpp"
+#include "GameRecord.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+static const int HAND_SIZE = Player::MAX_HAND_SIZE;
+
+// EFFECTS: Returns a few indices from each end of the range and some
+//          chosen at random
+static vector<uint64_t> sample_indices() {
+    vector<uint64_t> indices = {0, 1, 2, 3, 4, 5, 123456789,
+                                NUM_DEALS - 5, NUM_DEALS - 4, NUM_DEALS - 1};
+    Rng rng(14);
+    for (int i = 0; i < 2000; ++i) {
+        indices.push_back(((rng.next() >> 1) % NUM_DEALS));
+    }
+    return indices;
+}
+
+TEST(test_num_deals) {
+    // 24C5 * 19C5 * 14C5 * 9C5 ways to deal the hands, 4 choices of upcard
+    ASSERT_EQUAL(NUM_DEALS, uint64_t(42504) * 11628 * 2002 * 126 * 4);
+}
+
+TEST(test_deal_first) {
+    Deal deal = Deal_unrank(0);
+    ASSERT_TRUE(Deal_valid(deal));
+    // The lowest cards by Card_index go to the first hand
+    CardSet first;
+    for (const Card &card : {Card(NINE, SPADES), Card(NINE, HEARTS),
+                             Card(NINE, CLUBS), Card(NINE, DIAMONDS),
+                             Card(TEN, SPADES)}) {
+        first.add(card);
+    }
+    ASSERT_TRUE(deal.hands[0] == first);
+    ASSERT_EQUAL(deal.upcard, Card(ACE, SPADES));
+    ASSERT_EQUAL(deal.kitty.size(), 3);
+    ASSERT_EQUAL(Deal_rank(deal), uint64_t(0));
+
+    Deal last = Deal_unrank(NUM_DEALS - 1);
+    ASSERT_TRUE(Deal_valid(last));
+    ASSERT_TRUE(last.hands[0].contains(Card(ACE, DIAMONDS)));
+    ASSERT_EQUAL(last.upcard, Card(NINE, DIAMONDS));
+    ASSERT_EQUAL(Deal_rank(last), NUM_DEALS - 1);
+}
+
+TEST(test_deal_round_trip) {
+    for (uint64_t index : sample_indices()) {
+        Deal deal = Deal_unrank(index);
+        ASSERT_TRUE(Deal_valid(deal));
+        ASSERT_EQUAL(Deal_rank(deal), index);
+    }
+}
+
+static bool same_deal(const Deal &a, const Deal &b) {
+    for (int seat = 0; seat < 4; ++seat) {
+        if (a.hands[seat] != b.hands[seat]) {
+            return false;
+        }
+    }
+    return a.upcard == b.upcard && a.kitty == b.kitty;
+}
+
+// Relabelling the suits of a deal gives the same canonical deal, which
+// turns up a spade
+TEST(test_deal_canonical) {
+    vector<uint64_t> indices = sample_indices();
+    for (size_t i = 0; i < indices.size(); i += 10) {
+        Deal deal = Deal_unrank(indices[i]);
+        Deal canonical = Deal_canonical(deal);
+        ASSERT_TRUE(Deal_valid(canonical));
+        ASSERT_EQUAL(canonical.upcard.get_suit(), SPADES);
+        ASSERT_EQUAL(canonical.upcard.get_rank(), deal.upcard.get_rank());
+        ASSERT_TRUE(same_deal(Deal_canonical(canonical), canonical));
+
+        SuitMap map = SuitMap_from(static_cast<Suit>(i % 4), i % 8 < 4);
+        Deal relabelled;
+        for (int seat = 0; seat < 4; ++seat) {
+            relabelled.hands[seat] = map(deal.hands[seat]);
+        }
+        relabelled.upcard = map(deal.upcard);
+        relabelled.kitty = map(deal.kitty);
+        ASSERT_TRUE(same_deal(Deal_canonical(relabelled), canonical));
+    }
+}
+
+TEST(test_deal_valid_rejects) {
+    Deal deal = Deal_unrank(987654321);
+    Deal overlap = deal;
+    overlap.kitty = CardSet(overlap.kitty.get_bits() ^
+                            CardSet::bit(overlap.kitty.lowest()) ^
+                            CardSet::bit(overlap.hands[2].lowest()));
+    ASSERT_FALSE(Deal_valid(overlap));
+
+    Deal short_hand = deal;
+    short_hand.hands[1].remove(short_hand.hands[1].highest());
+    ASSERT_FALSE(Deal_valid(short_hand));
+
+    Deal non_euchre = deal;
+    non_euchre.upcard = Card(TWO, CLUBS);
+    ASSERT_FALSE(Deal_valid(non_euchre));
+}
+
+// The rank is ordered by the first hand, so the first hand changes least
+// often as the index goes up
+TEST(test_deal_order) {
+    uint64_t per_first_hand = NUM_DEALS / 42504;
+    Deal a = Deal_unrank(per_first_hand - 1);
+    Deal b = Deal_unrank(per_first_hand);
+    ASSERT_TRUE(a.hands[0] == Deal_unrank(0).hands[0]);
+    ASSERT_TRUE(b.hands[0] != a.hands[0]);
+}
+
+
+TEST(test_deal_iterator) {
+    DealIterator it(NUM_DEALS / 3 - 6);
+    for (int n = 0; n < 40; ++n, ++it) {
+        ASSERT_FALSE(it.done());
+        ASSERT_EQUAL(it.get_index(), NUM_DEALS / 3 - 6 + n);
+        ASSERT_TRUE(same_deal(*it, Deal_unrank(it.get_index())));
+    }
+
+    DealIterator end(NUM_DEALS - 2);
+    ++end;
+    ASSERT_EQUAL(end->upcard, Deal_unrank(NUM_DEALS - 1).upcard);
+    ++end;
+    ASSERT_TRUE(end.done());
+}
+
+// Strided iterators split the deals between workers with none missed
+TEST(test_deal_iterator_strided) {
+    const uint64_t workers = 3;
+    const uint64_t first = NUM_DEALS - 10;
+    vector<int> visits(10, 0);
+    for (uint64_t w = 0; w < workers; ++w) {
+        for (DealIterator it(first + w, workers); !it.done(); ++it) {
+            ASSERT_TRUE(same_deal(*it, Deal_unrank(it.get_index())));
+            ++visits[it.get_index() - first];
+        }
+    }
+    ASSERT_TRUE(visits == vector<int>(10, 1));
+
+    DealIterator big(5, NUM_DEALS);
+    ++big;
+    ASSERT_TRUE(big.done());
+}
+
+// A game dealt from Deal_pack gives each seat its hand and turns up the
+// upcard
+TEST(test_deal_pack) {
+    for (uint64_t index : {uint64_t(0), uint64_t(31415926535), NUM_DEALS - 1}) {
+        Deal deal = Deal_unrank(index);
+        Game game(Deal_pack(deal, 0), 1, false,
+                  {{"Edsger", "Simple"}, {"Fran", "Simple"},
+                   {"Gabriel", "Simple"}, {"Herb", "Simple"}});
+        GameRecord record;
+        ostringstream os;
+        GameLog log(os, LOG_NONE);
+        game.play(log, &record);
+
+        const HandRecord &hand = record.hands[0];
+        ASSERT_EQUAL(hand.dealer, 0);
+        ASSERT_EQUAL(hand.upcard, deal.upcard);
+        Card dealt[4][HAND_SIZE];
+        HandRecord_deal(hand, dealt);
+        // The dealer may have picked up the upcard
+        for (int seat = 1; seat < 4; ++seat) {
+            CardSet cards;
+            for (const Card &card : dealt[seat]) {
+                cards.add(card);
+            }
+            ASSERT_TRUE(cards == deal.hands[seat]);
+        }
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,412 @@
+#include "Game.hpp"
+#include "Deal.hpp"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+void SimStats::add(const GameResult &result) {
+    games++;
+    team_wins[result.winning_team]++;
+    hands += result.hands;
+    euchres += result.euchres;
+    marches += result.marches;
+}
+
+void SimStats::merge(const SimStats &other) {
+    games += other.games;
+    team_wins[0] += other.team_wins[0];
+    team_wins[1] += other.team_wins[1];
+    hands += other.hands;
+    euchres += other.euchres;
+    marches += other.marches;
+}
+
+HandScore score_hand(int team1_tricks, bool team1_ordered_up) {
+    assert(team1_tricks >= 0 && team1_tricks <= 5);
+    HandScore score;
+    bool team1_won = team1_tricks >= 3;
+    int tricks = team1_won ? team1_tricks : 5 - team1_tricks;
+    score.winning_team = team1_won ? 0 : 1;
+    score.euchred = (team1_won != team1_ordered_up);
+    score.march = !score.euchred && tricks == 5;
+    score.points = (score.euchred || score.march) ? 2 : 1;
+    return score;
+}
+
+void DuplicateStats::add(int first, int second) {
+    boards++;
+    sum += first + second;
+    sum_squares += double(first + second) * (first + second);
+    hand_sum_squares += double(first) * first + double(second) * second;
+}
+
+void DuplicateStats::merge(const DuplicateStats &other) {
+    boards += other.boards;
+    sum += other.sum;
+    sum_squares += other.sum_squares;
+    hand_sum_squares += other.hand_sum_squares;
+}
+
+double DuplicateStats::mean() const {
+    return boards > 0 ? sum / boards : 0;
+}
+
+double DuplicateStats::standard_error() const {
+    if (boards < 2) {
+        return 0;
+    }
+    double variance = (sum_squares - boards * mean() * mean()) / (boards - 1);
+    return sqrt(max(variance, 0.0) / boards);
+}
+
+// Each play alone is a hand with mean net points mean() / 2. A board of two
+// independent hands scores their sum, with twice the variance of one hand.
+double DuplicateStats::independent_error() const {
+    long long hands = 2 * boards;
+    if (hands < 2) {
+        return 0;
+    }
+    double hand_mean = sum / hands;
+    double variance = (hand_sum_squares - hands * hand_mean * hand_mean) /
+                      (hands - 1);
+    return sqrt(2 * max(variance, 0.0) / boards);
+}
+
+ostream & operator<<(ostream &os, const DuplicateStats &stats) {
+    double error = stats.standard_error();
+    double independent = stats.independent_error();
+    os << "boards " << stats.boards << "\n"
+       << "points per board " << stats.mean() << "\n"
+       << "standard error " << error << "\n"
+       << "standard error without duplicate " << independent << "\n";
+    if (error > 0) {
+        os << "variance reduction " << independent * independent / (error * error)
+           << "\n";
+    }
+    return os;
+}
+
+ostream & operator<<(ostream &os, const SimStats &stats) {
+    double games = stats.games > 0 ? stats.games : 1;
+    double hands = stats.hands > 0 ? stats.hands : 1;
+    os << "games " << stats.games << "\n"
+       << "team 1 wins " << stats.team_wins[0] << "\n"
+       << "team 2 wins " << stats.team_wins[1] << "\n"
+       << "hands per game " << stats.hands / games << "\n"
+       << "euchre rate " << stats.euchres / hands << "\n"
+       << "march rate " << stats.marches / hands << "\n";
+    return os;
+}
+
+Game::Game(const Pack &pack_in, int points_to_win, bool shuffle,
+           const vector<pair<string, string>> &input_players) :
+    first_pack(pack_in), pack(pack_in), points_to_win(points_to_win), team1score(0),
+    team2score(0), bool_shuffle(shuffle), random_shuffle(false),
+    corpus(nullptr), corpus_first(0), dealer_index(0), hand_num(0),
+    team1_ordered_up(false), log(nullptr), record(nullptr),
+    counters(nullptr), stats(nullptr) {
+
+    players.reserve(input_players.size());
+    for (const pair<string, string> &p : input_players) {
+        players.emplace_back(p.first, p.second);
+    }
+}
+
+void Game::reset() {
+    pack = first_pack;
+    team1score = 0;
+    team2score = 0;
+    random_shuffle = false;
+    corpus = nullptr;
+    corpus_first = 0;
+    dealer_index = 0;
+    hand_num = 0;
+    team1_ordered_up = false;
+    for (Seat &seat : players) {
+        seat.reset();
+    }
+}
+
+void Game::reset(const Rng &rng_in) {
+    reset();
+    use_random_shuffle(rng_in);
+}
+
+void Game::use_random_shuffle(const Rng &rng_in) {
+    random_shuffle = true;
+    rng = rng_in;
+}
+
+void Game::use_corpus(const PackCorpus *corpus_in, long long first) {
+    corpus = corpus_in;
+    corpus_first = first;
+}
+
+void Game::use_counters(PerfCounters *counters_in) {
+    counters = counters_in;
+}
+
+void Game::use_stats(StatsShard *stats_in) {
+    stats = stats_in;
+}
+
+HandScore Game::play_board(int dealer, GameLog &log_in) {
+    assert(0 <= dealer && dealer < 4);
+    log = &log_in;
+    dealer_index = dealer;
+    if (log->shows(LOG_FULL)) {
+        *log << players[dealer_index].get_name() << " deals" << '\n';
+    }
+    deal();
+    if (log->shows(LOG_FULL)) {
+        *log << upcard << " turned up" << '\n';
+    }
+    make_trump();
+    HandScore score = score_hand(play_hand(), team1_ordered_up);
+    hand_num++;
+    dealer_index = (dealer_index + 1) % 4;
+    log->flush();
+    log = nullptr;
+    return score;
+}
+
+GameResult Game::play(bool narrate) {
+    GameLog cout_log(cout, narrate ? LOG_FULL : LOG_NONE, 0);
+    return play(cout_log);
+}
+
+GameResult Game::play(GameLog &log_in, GameRecord *record_in) {
+    log = &log_in;
+    record = record_in;
+    result = GameResult();
+    if (record) {
+        record->points_to_win = points_to_win;
+        for (int i = 0; i < 4; ++i) {
+            record->names[i] = players[i].get_name();
+        }
+        record->hands.clear();
+    }
+
+    while (team1score < points_to_win && team2score < points_to_win) {
+        if (log->shows(LOG_SUMMARY)) {
+            *log << "Hand " << hand_num << '\n';
+        }
+        if (record) {
+            record->hands.emplace_back();
+            record->hands.back().dealer = dealer_index;
+        }
+        if (log->shows(LOG_FULL)) {
+            *log << players[dealer_index].get_name() << " deals" << '\n';
+        }
+        deal(); //gives each person 5 new cards
+
+        if (log->shows(LOG_FULL)) {
+            *log << upcard << " turned up" << '\n';
+        }
+        make_trump(); //sets upcard / trump
+
+        int team1_tricks_won = play_hand(); //play the hand out
+        award_score(team1_tricks_won); //update each teams score
+
+        hand_num++;
+        dealer_index = (dealer_index + 1) % 4;
+    }
+
+    result.hands = hand_num;
+    result.winning_team = (team1score > team2score) ? 0 : 1;
+    if (log->shows(LOG_SUMMARY)) {
+        int first = result.winning_team;
+        *log << players[first].get_name() << " and " <<
+        players[first + 2].get_name() << " win!" << '\n';
+    }
+    log->flush();
+    log = nullptr;
+    record = nullptr;
+    return result;
+}
+
+void Game::deal() {
+    PhaseScope scope(counters, PHASE_DEAL);
+    if (corpus) {
+        array<Card, Pack::PACK_SIZE> cards;
+        corpus->get((corpus_first + hand_num) % corpus->size(), cards);
+        pack = Pack(cards);
+    }
+    else if (bool_shuffle && random_shuffle) {
+        pack.shuffle(rng);
+    }
+    else if (bool_shuffle) {
+        pack.shuffle();
+    }
+    else {
+        pack.reset();
+    }
+
+    //deal 5 cards to each player starting from left of dealer
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 4; i++) {
+
+            int player_index = (dealer_index + 1 + i) % 4;
+
+            for (int j = 0; j < DEAL_BATCHES[round*4 + i]; j++){
+                Card card = pack.deal_one();
+                if (player_index == dealer_index) {
+                    dealer_cards[round == 0 ? j : DEAL_BATCHES[i] + j] = card;
+                }
+                players[player_index].add_card(card);
+            }
+
+        }
+    }
+
+    upcard = pack.deal_one();
+    if (record) {
+        record->hands.back().upcard = upcard;
+    }
+}
+
+void Game::make_trump() {
+    PhaseScope scope(counters, PHASE_BIDDING);
+    Suit orderUp = upcard.get_suit();
+    for (int round = 1; round <= 2; round++) {
+        for (int i = 1; i < 5; i++) {
+            int current_player = (dealer_index + i) % 4;
+            bool is_dealer = (current_player == dealer_index);
+            Seat &player = players[current_player];
+
+            if (decide([&] {
+                    return player.make_trump(upcard, is_dealer, round, orderUp);
+                })) {
+                trump = orderUp;
+                if (log->shows(LOG_SUMMARY)) {
+                    *log << player.get_name() << " orders up " << orderUp << '\n';
+                }
+
+                if (round == 1) {
+                    decide([&] { players[dealer_index].add_and_discard(upcard); });
+                }
+                for (int j = 0; j < 4; ++j) {
+                    players[j].see_trump(upcard, (dealer_index - j + 4) % 4,
+                                          (current_player - j + 4) % 4, trump);
+                }
+                team1_ordered_up = (current_player % 2 == 0);
+                if (record) {
+                    record->hands.back().passes = (round - 1) * 4 + i - 1;
+                    record->hands.back().trump = trump;
+                }
+                return;
+            }
+
+            if (log->shows(LOG_FULL)) {
+                *log << player.get_name() << " passes" << '\n';
+            }
+        }
+    }
+}
+
+int Game::play_hand() {
+    int team1_tricks_won = 0;
+    int lead_player_index = (dealer_index + 1) % 4;
+
+    PhaseScope play_scope(counters, PHASE_PLAY);
+    for (int round_number = 0; round_number < 5; ++round_number) {
+        Card trick[TRICK_SIZE];
+        trick[0] = decide([&] {
+            return players[lead_player_index].lead_card(trump);
+        });
+        show_play(trick[0], lead_player_index);
+        if (log->shows(LOG_FULL)) {
+            *log << trick[0] << " led by "
+                 << players[lead_player_index].get_name() << '\n';
+        }
+
+        for (int i = 1; i < TRICK_SIZE; ++i) {
+            Seat &curr_player = players[(lead_player_index + i) % 4];
+            trick[i] = decide([&] { return curr_player.play_card(trick[0], trump); });
+            show_play(trick[i], (lead_player_index + i) % 4);
+
+            if (log->shows(LOG_FULL)) {
+                *log << trick[i] << " played by " << curr_player.get_name() << '\n';
+            }
+        }
+        if (record) {
+            copy(trick, trick + TRICK_SIZE,
+                 record->hands.back().plays + round_number * TRICK_SIZE);
+        }
+
+        lead_player_index = (lead_player_index + Trick_winner(trick, trump)) % 4;
+        if (log->shows(LOG_FULL)) {
+            *log << players[lead_player_index].get_name()
+                 << " takes the trick" << '\n';
+        }
+        team1_tricks_won += (lead_player_index % 2 == 0);
+    }
+
+    if (record) {
+        record_discard();
+    }
+    return team1_tricks_won;
+}
+
+// Shows every player the card played by players[player_index]
+void Game::show_play(const Card &card, int player_index) {
+    for (int j = 0; j < 4; ++j) {
+        players[j].see_play(card, (player_index - j + 4) % 4);
+    }
+}
+
+void Game::record_discard() {
+    HandRecord &hand = record->hands.back();
+    if (hand.passes >= 4) {
+        return;
+    }
+    // The dealer's discard is the one dealt card the dealer never played
+    int seats[PLAYS_PER_HAND];
+    HandRecord_seats(hand, seats);
+    for (const Card &card : dealer_cards) {
+        bool played = false;
+        for (int i = 0; i < PLAYS_PER_HAND; ++i) {
+            played = played || (seats[i] == dealer_index && hand.plays[i] == card);
+        }
+        if (!played) {
+            hand.discard = card;
+            return;
+        }
+    }
+    hand.discard = upcard;
+}
+
+void Game::award_score(int team1wins) {
+    PhaseScope scope(counters, PHASE_SCORING);
+    HandScore score = score_hand(team1wins, team1_ordered_up);
+    int first = score.winning_team;
+    (first == 0 ? team1score : team2score) += score.points;
+    result.euchres += score.euchred;
+    result.marches += score.march;
+    if (stats) {
+        stats->add(score, dealer_index, team1wins);
+    }
+
+    if (log->shows(LOG_SUMMARY)) {
+        *log << players[first].get_name() << " and "
+             << players[first + 2].get_name() << " win the hand" << '\n';
+        if (score.euchred) {
+            *log << "euchred!" << '\n';
+        }
+        else if (score.march) {
+            *log << "march!" << '\n';
+        }
+        *log << players[0].get_name() << " and " << players[2].get_name()
+        << " have " << team1score << " points" << '\n';
+
+        *log << players[1].get_name() << " and " << players[3].get_name()
+        << " have " << team2score << " points" << '\n';
+    }
+}
@@ -0,0 +1,212 @@
+#ifndef GAME_HPP
+#define GAME_HPP
+/* Game.hpp
+ *
+ * A game of euchre between four players
+ */
+
+#include "Card.hpp"
+#include "GameLog.hpp"
+#include "GameRecord.hpp"
+#include "HandStats.hpp"
+#include "Pack.hpp"
+#include "PackCorpus.hpp"
+#include "PerfCounters.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "Seat.hpp"
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Outcome of one game, as returned by Game::play()
+struct GameResult {
+  int winning_team = 0; // 0 for players 0 and 2, 1 for players 1 and 3
+  int hands = 0;        // number of hands dealt
+  int euchres = 0;      // hands in which the makers were euchred
+  int marches = 0;      // hands in which the makers took all five tricks
+};
+
+// Running totals over a batch of games
+struct SimStats {
+  long long games = 0;
+  long long team_wins[2] = {0, 0};
+  long long hands = 0;
+  long long euchres = 0;
+  long long marches = 0;
+
+  //EFFECTS adds one game's result to the totals
+  void add(const GameResult &result);
+
+  //EFFECTS adds other's totals to these totals
+  void merge(const SimStats &other);
+};
+
+// Outcome of one hand
+struct HandScore {
+  int winning_team; // 0 for players 0 and 2, 1 for players 1 and 3
+  int points;       // points won, 1 or 2
+  bool euchred;     // the makers took fewer than three tricks
+  bool march;       // the makers took all five tricks
+};
+
+//REQUIRES team1_tricks is from 0 to 5
+//EFFECTS Scores a hand in which players 0 and 2 took team1_tricks tricks
+HandScore score_hand(int team1_tricks, bool team1_ordered_up);
+
+//REQUIRES points_to_win >= 1
+//EFFECTS Returns the most hands a game to points_to_win can last. Every
+//  hand scores a point, so a team has points_to_win points by then.
+inline int max_hands_per_game(int points_to_win) {
+  return 2 * points_to_win - 1;
+}
+
+//EFFECTS Returns the points players 0 and 2 won in a hand, less the points
+//  players 1 and 3 won
+inline int HandScore_net(const HandScore &score) {
+  return score.winning_team == 0 ? score.points : -score.points;
+}
+
+// Running totals over duplicate boards. A board is one deal played twice,
+// the second time with the teams' seats swapped, so that each team plays
+// both sides of the cards. A board's score is one team's net points over
+// both plays; luck of the cards cancels out of it, as in duplicate bridge.
+struct DuplicateStats {
+  long long boards = 0;
+  double sum = 0;              // of the board scores
+  double sum_squares = 0;      // of the board scores
+  double hand_sum_squares = 0; // of the net points of each play alone
+
+  //EFFECTS adds a board on which the team scored first net points in the
+  //  first play and second in the second
+  void add(int first, int second);
+
+  //EFFECTS adds other's totals to these totals
+  void merge(const DuplicateStats &other);
+
+  //EFFECTS Returns the mean board score
+  double mean() const;
+
+  //EFFECTS Returns the standard error of mean()
+  double standard_error() const;
+
+  //EFFECTS Returns the standard error mean() would have if the hands of
+  //  each board had been dealt independently rather than duplicated
+  double independent_error() const;
+};
+
+//EFFECTS Prints the boards, mean score per board and its standard error,
+//  and the variance reduction: how many times as many hands independent
+//  deals would need for the same standard error
+std::ostream & operator<<(std::ostream &os, const DuplicateStats &stats);
+
+//EFFECTS Prints wins per team, average hands per game and the
+//  euchre and march rates per hand
+std::ostream & operator<<(std::ostream &os, const SimStats &stats);
+
+class Game {
+public:
+  // REQUIRES: input_players holds four (name, strategy) pairs
+  // EFFECTS: Creates a game dealt from a copy of pack_in. Players 0 and 2
+  //          are one team, players 1 and 3 the other.
+  Game(const Pack &pack_in, int points_to_win, bool shuffle,
+       const std::vector<std::pair<std::string, std::string>> &input_players);
+
+  // Games own their players, so they cannot be copied
+  Game(const Game &) = delete;
+  Game & operator=(const Game &) = delete;
+
+  // EFFECTS: Starts a new game with the same players, as if the game had
+  //          just been constructed, except that hardware counters and
+  //          stats stay in use. Scores, the dealer and the pack go back to
+  //          their starting state, random shuffling and any corpus are
+  //          turned off, and every player is reset. Nothing is allocated,
+  //          so one game can play any number of games in turn.
+  void reset();
+
+  // EFFECTS: Starts a new game as reset() does, then shuffles with rng as
+  //          use_random_shuffle does
+  void reset(const Rng &rng);
+
+  // EFFECTS: From the next hand on, a shuffling game shuffles the pack
+  //          uniformly at random with rng instead of with in shuffles.
+  void use_random_shuffle(const Rng &rng);
+
+  // REQUIRES: corpus is open and outlives the game
+  // EFFECTS: From the next hand on, hand k of the game, counting from 0, is
+  //          dealt from pack first + k of corpus, wrapping around at its
+  //          end, instead of from this game's own pack. Games that start
+  //          max_hands_per_game packs apart deal no pack twice until the
+  //          corpus wraps around.
+  void use_corpus(const PackCorpus *corpus, long long first);
+
+  // EFFECTS: If counters is not null, hardware events in each phase of
+  //          every later hand, and in each player decision, are added to
+  //          counters. The counters must have been opened on the thread
+  //          that calls play().
+  void use_counters(PerfCounters *counters);
+
+  // EFFECTS: If stats is not null, every later hand of play() is added to
+  //          stats as it is scored. Only the thread that calls play() may
+  //          add to stats.
+  void use_stats(StatsShard *stats);
+
+  // MODIFIES: record
+  // EFFECTS: Plays hands until one team reaches points_to_win, writing
+  //          narration to log at the log's level. If record is not null,
+  //          it is filled with the names, bids and plays of the game.
+  GameResult play(GameLog &log, GameRecord *record = nullptr);
+
+  // REQUIRES: 0 <= dealer < 4
+  // EFFECTS: Deals one hand from seat dealer, as the next hand of the game
+  //          would be dealt, plays it out and returns its score, without
+  //          adding to the game's score. Duplicate boards play the same
+  //          deal this way in two games with the teams' seats swapped.
+  HandScore play_board(int dealer, GameLog &log);
+
+  // EFFECTS: Plays hands until one team reaches points_to_win. If narrate
+  //          is true every deal, bid and trick is printed to cout as soon
+  //          as it happens.
+  GameResult play(bool narrate);
+
+private:
+  std::vector<Seat> players;
+  Card upcard;
+  Pack first_pack; // the pack as given, restored by reset()
+  Pack pack;
+  Suit trump;
+  int points_to_win;
+  int team1score;
+  int team2score;
+  bool bool_shuffle;
+  bool random_shuffle;
+  Rng rng;
+  const PackCorpus *corpus; // may be null
+  long long corpus_first;
+  int dealer_index; //which player is dealer 0-3
+  int hand_num; //what round of game its on
+  bool team1_ordered_up;
+  GameLog *log; // only set during play()
+  GameRecord *record; // only set during play(), may be null
+  PerfCounters *counters; // may be null
+  StatsShard *stats; // may be null
+  Card dealer_cards[Player::MAX_HAND_SIZE]; // the dealer's cards as dealt
+  GameResult result;
+
+  void deal();
+  void make_trump();
+  int play_hand();
+  void show_play(const Card &card, int player_index);
+  void record_discard();
+  void award_score(int team1wins);
+
+  // Calls decision, counting it as a player decision
+  template <class Decision>
+  auto decide(Decision decision) {
+    PhaseScope scope(counters, PHASE_DECISION);
+    return decision();
+  }
+};
+
+#endif // GAME_HPP
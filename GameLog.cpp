@@ -0,0 +1,86 @@
+#include "GameLog.hpp"
+#include <cassert>
+#include <charconv>
+#include <mutex>
+#include <string>
+
+using namespace std;
+
+bool string_to_log_level(const string &str, LogLevel &level) {
+    if (str == "none") {
+        level = LOG_NONE;
+    } else if (str == "summary") {
+        level = LOG_SUMMARY;
+    } else if (str == "full") {
+        level = LOG_FULL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+GameLog::GameLog(ostream &os, LogLevel level, size_t block_size,
+                 mutex *sink_lock) :
+    os(os), level(level), block_size(block_size), sink_lock(sink_lock) {
+    if (level > LOG_NONE) {
+        buffer.reserve(block_size > 0 ? block_size + 256 : 256);
+    }
+}
+
+GameLog::~GameLog() {
+    flush();
+}
+
+GameLog & GameLog::operator<<(const char *str) {
+    buffer += str;
+    return *this;
+}
+
+GameLog & GameLog::operator<<(const string &str) {
+    buffer += str;
+    return *this;
+}
+
+GameLog & GameLog::operator<<(char c) {
+    buffer += c;
+    if (c == '\n' && buffer.size() >= block_size) {
+        flush();
+    }
+    return *this;
+}
+
+GameLog & GameLog::operator<<(int n) {
+    char digits[16];
+    to_chars_result end = to_chars(digits, digits + sizeof(digits), n);
+    assert(end.ec == errc());
+    buffer.append(digits, end.ptr);
+    return *this;
+}
+
+GameLog & GameLog::operator<<(Rank rank) {
+    buffer += Rank_name(rank);
+    return *this;
+}
+
+GameLog & GameLog::operator<<(Suit suit) {
+    buffer += Suit_name(suit);
+    return *this;
+}
+
+GameLog & GameLog::operator<<(const Card &card) {
+    return *this << card.get_rank() << " of " << card.get_suit();
+}
+
+void GameLog::flush() {
+    if (buffer.empty()) {
+        return;
+    }
+    if (sink_lock) {
+        lock_guard<mutex> guard(*sink_lock);
+        os.write(buffer.data(), buffer.size());
+    } else {
+        os.write(buffer.data(), buffer.size());
+    }
+    os.flush();
+    buffer.clear();
+}
@@ -0,0 +1,74 @@
+#ifndef GAMELOG_HPP
+#define GAMELOG_HPP
+/* GameLog.hpp
+ *
+ * Buffered narration of a game
+ */
+
+#include "Card.hpp"
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+// How much of a game is written to the log
+enum LogLevel {
+  LOG_NONE    = 0, // nothing
+  LOG_SUMMARY = 1, // bids, hand results and scores
+  LOG_FULL    = 2, // every deal, bid and trick
+};
+
+//REQUIRES str is "none", "summary" or "full"
+//MODIFIES level
+//EFFECTS Sets level from its name. Returns false if str is not a level.
+bool string_to_log_level(const std::string &str, LogLevel &level);
+
+// Formats log text into a reusable buffer and writes it to a stream in
+// blocks of at least block_size bytes, so narration costs one write per
+// block instead of one flush per line. The log writes whatever it is
+// given; callers check shows() first, so that text above the log level is
+// never formatted.
+class GameLog {
+public:
+  // Default size of a block written to the stream
+  static const size_t DEFAULT_BLOCK_SIZE = 1 << 16;
+
+  // EFFECTS: Creates a log writing to os. A block_size of 0 writes every
+  //          line as soon as it ends, for interactive games. If sink_lock
+  //          is not null, it is held while a block is written, so logs on
+  //          several threads can share os without splitting blocks.
+  GameLog(std::ostream &os, LogLevel level,
+          size_t block_size = DEFAULT_BLOCK_SIZE,
+          std::mutex *sink_lock = nullptr);
+
+  // EFFECTS: Writes out any buffered text
+  ~GameLog();
+
+  GameLog(const GameLog &) = delete;
+  GameLog & operator=(const GameLog &) = delete;
+
+  // EFFECTS: Returns true if text at the given level is written
+  bool shows(LogLevel at) const {
+    return at <= level;
+  }
+
+  GameLog & operator<<(const char *str);
+  GameLog & operator<<(const std::string &str);
+  GameLog & operator<<(char c);
+  GameLog & operator<<(int n);
+  GameLog & operator<<(Rank rank);
+  GameLog & operator<<(Suit suit);
+  GameLog & operator<<(const Card &card);
+
+  // EFFECTS: Writes all buffered text to the stream
+  void flush();
+
+private:
+  std::ostream &os;
+  LogLevel level;
+  size_t block_size;
+  std::mutex *sink_lock;
+  std::string buffer;
+};
+
+#endif // GAMELOG_HPP
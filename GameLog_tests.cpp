@@ -0,0 +1,63 @@
+#include "GameLog.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+TEST(test_game_log_formats) {
+    ostringstream os;
+    {
+        GameLog log(os, LOG_FULL);
+        log << Card(JACK, DIAMONDS) << " led by " << string("Adi") << '\n';
+        log << "Adi has " << -12 << " points" << '\n';
+        log << ACE << ' ' << CLUBS << '\n';
+    }
+    ASSERT_EQUAL(os.str(), "Jack of Diamonds led by Adi\n"
+                           "Adi has -12 points\n"
+                           "Ace Clubs\n");
+}
+
+// Text stays in the buffer until a block fills or the log is flushed
+TEST(test_game_log_blocks) {
+    ostringstream os;
+    GameLog log(os, LOG_FULL, 10);
+    log << "short" << '\n';
+    ASSERT_EQUAL(os.str(), "");
+    log << "longer line" << '\n';
+    ASSERT_EQUAL(os.str(), "short\nlonger line\n");
+    log << "tail" << '\n';
+    log.flush();
+    ASSERT_EQUAL(os.str(), "short\nlonger line\ntail\n");
+}
+
+// A block size of 0 writes every line as soon as it ends
+TEST(test_game_log_unbuffered) {
+    ostringstream os;
+    GameLog log(os, LOG_FULL, 0);
+    log << "one";
+    ASSERT_EQUAL(os.str(), "");
+    log << '\n';
+    ASSERT_EQUAL(os.str(), "one\n");
+}
+
+TEST(test_game_log_levels) {
+    ostringstream os;
+    GameLog none(os, LOG_NONE);
+    GameLog summary(os, LOG_SUMMARY);
+    GameLog full(os, LOG_FULL);
+
+    ASSERT_FALSE(none.shows(LOG_SUMMARY));
+    ASSERT_TRUE(summary.shows(LOG_SUMMARY));
+    ASSERT_FALSE(summary.shows(LOG_FULL));
+    ASSERT_TRUE(full.shows(LOG_FULL));
+
+    LogLevel level = LOG_NONE;
+    ASSERT_TRUE(string_to_log_level("summary", level));
+    ASSERT_EQUAL(level, LOG_SUMMARY);
+    ASSERT_FALSE(string_to_log_level("loud", level));
+    ASSERT_EQUAL(level, LOG_SUMMARY);
+}
+
+TEST_MAIN()
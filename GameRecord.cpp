@@ -0,0 +1,222 @@
+#include "GameRecord.hpp"
+#include "Game.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char MAGIC[] = {'E', 'U', 'C', 'R'};
+static const char VERSION = 1;
+static const char GAME_TAG = 'G';
+
+void HandRecord_seats(const HandRecord &hand, int seats[PLAYS_PER_HAND]) {
+    int leader = (hand.dealer + 1) % 4;
+    for (int trick = 0; trick < PLAYS_PER_HAND; trick += TRICK_SIZE) {
+        for (int i = 0; i < TRICK_SIZE; ++i) {
+            seats[trick + i] = (leader + i) % 4;
+        }
+        leader = seats[trick + Trick_winner(hand.plays + trick, hand.trump)];
+    }
+}
+
+void HandRecord_deal(const HandRecord &hand,
+                     Card deal[4][Player::MAX_HAND_SIZE]) {
+    int seats[PLAYS_PER_HAND];
+    HandRecord_seats(hand, seats);
+
+    int dealt[4] = {0, 0, 0, 0};
+    for (int i = 0; i < PLAYS_PER_HAND; ++i) {
+        deal[seats[i]][dealt[seats[i]]++] = hand.plays[i];
+    }
+
+    // The dealer played the upcard in place of the discard
+    if (hand.passes < 4) {
+        for (Card &card : deal[hand.dealer]) {
+            if (card == hand.upcard) {
+                card = hand.discard;
+            }
+        }
+    }
+}
+
+SolverPosition HandRecord_position(const HandRecord &hand) {
+    Card deal[4][Player::MAX_HAND_SIZE];
+    HandRecord_deal(hand, deal);
+
+    SolverPosition position;
+    for (int seat = 0; seat < 4; ++seat) {
+        for (const Card &card : deal[seat]) {
+            position.hands[seat].add(card);
+        }
+    }
+    position.trump = hand.trump;
+    position.leader = (hand.dealer + 1) % 4;
+    return position;
+}
+
+// EFFECTS: Writes the bidding and tricks of hand, as Game::play does
+static void narrate_hand(const GameRecord &game, const HandRecord &hand,
+                         GameLog &log) {
+    const string *names = game.names;
+    if (log.shows(LOG_FULL)) {
+        log << names[hand.dealer] << " deals" << '\n';
+        log << hand.upcard << " turned up" << '\n';
+        for (int i = 1; i <= hand.passes; ++i) {
+            log << names[(hand.dealer + i) % 4] << " passes" << '\n';
+        }
+    }
+    int maker = (hand.dealer + hand.passes + 1) % 4;
+    log << names[maker] << " orders up " << hand.trump << '\n';
+    if (!log.shows(LOG_FULL)) {
+        return;
+    }
+
+    int seats[PLAYS_PER_HAND];
+    HandRecord_seats(hand, seats);
+    for (int trick = 0; trick < PLAYS_PER_HAND; trick += TRICK_SIZE) {
+        log << hand.plays[trick] << " led by " << names[seats[trick]] << '\n';
+        for (int i = 1; i < TRICK_SIZE; ++i) {
+            log << hand.plays[trick + i] << " played by "
+                << names[seats[trick + i]] << '\n';
+        }
+        int winner = seats[trick + Trick_winner(hand.plays + trick, hand.trump)];
+        log << names[winner] << " takes the trick" << '\n';
+    }
+}
+
+// EFFECTS: Returns the tricks taken by players 0 and 2 in hand
+static int team1_tricks(const HandRecord &hand) {
+    int seats[PLAYS_PER_HAND];
+    HandRecord_seats(hand, seats);
+    int tricks = 0;
+    for (int trick = 0; trick < PLAYS_PER_HAND; trick += TRICK_SIZE) {
+        int winner = seats[trick + Trick_winner(hand.plays + trick, hand.trump)];
+        tricks += (winner % 2 == 0);
+    }
+    return tricks;
+}
+
+void GameRecord_narrate(const GameRecord &game, GameLog &log) {
+    if (!log.shows(LOG_SUMMARY)) {
+        return;
+    }
+    const string *names = game.names;
+    int scores[2] = {0, 0};
+    for (size_t n = 0; n < game.hands.size(); ++n) {
+        const HandRecord &hand = game.hands[n];
+        log << "Hand " << static_cast<int>(n) << '\n';
+        narrate_hand(game, hand, log);
+
+        bool team1_ordered_up = (hand.dealer + hand.passes + 1) % 2 == 0;
+        HandScore score = score_hand(team1_tricks(hand), team1_ordered_up);
+        int first = score.winning_team;
+        scores[first] += score.points;
+        log << names[first] << " and " << names[first + 2]
+            << " win the hand" << '\n';
+        if (score.euchred) {
+            log << "euchred!" << '\n';
+        } else if (score.march) {
+            log << "march!" << '\n';
+        }
+        log << names[0] << " and " << names[2] << " have " << scores[0]
+            << " points" << '\n';
+        log << names[1] << " and " << names[3] << " have " << scores[1]
+            << " points" << '\n';
+    }
+    int first = scores[0] > scores[1] ? 0 : 1;
+    log << names[first] << " and " << names[first + 2] << " win!" << '\n';
+}
+
+GameRecordWriter::GameRecordWriter(ostream &os) : os(os) {
+    os.write(MAGIC, sizeof(MAGIC));
+    os.put(VERSION);
+}
+
+void GameRecordWriter::write(const GameRecord &game) {
+    assert(!game.hands.empty());
+    assert(game.points_to_win < 256);
+
+    buffer.clear();
+    buffer += GAME_TAG;
+    buffer += static_cast<char>(game.points_to_win);
+    for (const string &name : game.names) {
+        assert(name.size() < 256);
+        buffer += static_cast<char>(name.size());
+        buffer += name;
+    }
+    for (size_t n = 0; n < game.hands.size(); ++n) {
+        const HandRecord &hand = game.hands[n];
+        bool last = (n + 1 == game.hands.size());
+        buffer += static_cast<char>(hand.dealer | hand.passes << 2 |
+                                    hand.trump << 5 | last << 7);
+        buffer += static_cast<char>(Card_index(hand.upcard));
+        buffer += static_cast<char>(Card_index(hand.discard));
+        for (const Card &card : hand.plays) {
+            buffer += static_cast<char>(Card_index(card));
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
+GameRecordReader::GameRecordReader(istream &is) : is(is), valid(true) {
+    char header[sizeof(MAGIC) + 1];
+    if (!is.read(header, sizeof(header)) ||
+        string(header, sizeof(MAGIC)) != string(MAGIC, sizeof(MAGIC)) ||
+        header[sizeof(MAGIC)] != VERSION) {
+        valid = false;
+    }
+}
+
+// EFFECTS: Returns the card with the given Card_index, or false if index
+//          is out of range
+static bool index_to_card(unsigned char index, Card &card) {
+    if (index >= NUM_CARD_INDICES) {
+        return false;
+    }
+    card = Card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+    return true;
+}
+
+bool GameRecordReader::read_hand(HandRecord &hand, bool &last) {
+    unsigned char bytes[3 + PLAYS_PER_HAND];
+    if (!is.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+        return false;
+    }
+    hand.dealer = bytes[0] & 3;
+    hand.passes = (bytes[0] >> 2) & 7;
+    hand.trump = static_cast<Suit>((bytes[0] >> 5) & 3);
+    last = (bytes[0] >> 7) != 0;
+    bool ok = index_to_card(bytes[1], hand.upcard) &&
+              index_to_card(bytes[2], hand.discard);
+    for (int i = 0; i < PLAYS_PER_HAND; ++i) {
+        ok = ok && index_to_card(bytes[3 + i], hand.plays[i]);
+    }
+    return ok;
+}
+
+bool GameRecordReader::read(GameRecord &game) {
+    int tag = is.get();
+    if (!valid || tag != GAME_TAG) {
+        valid = false;
+        return false;
+    }
+    game.points_to_win = is.get();
+    for (string &name : game.names) {
+        int length = is.get();
+        name.resize(length > 0 ? length : 0);
+        is.read(&name[0], name.size());
+    }
+
+    game.hands.clear();
+    bool last = false;
+    while (!last) {
+        game.hands.emplace_back();
+        if (!is || !read_hand(game.hands.back(), last)) {
+            valid = false;
+            return false;
+        }
+    }
+    return true;
+}
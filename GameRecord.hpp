@@ -0,0 +1,95 @@
+#ifndef GAMERECORD_HPP
+#define GAMERECORD_HPP
+/* GameRecord.hpp
+ *
+ * Compact binary records of played games
+ */
+
+#include "Card.hpp"
+#include "GameLog.hpp"
+#include "Player.hpp"
+#include "Solver.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Number of cards played in one hand
+const int PLAYS_PER_HAND = 5 * TRICK_SIZE;
+
+// One hand of a recorded game. The deal is not stored: every dealt card
+// is played, apart from the one the dealer discards, so HandRecord_deal
+// can rebuild it.
+struct HandRecord {
+  int dealer = 0;      // seat of the dealer, 0-3
+  int passes = 0;      // players who passed before trump was made, 0-7
+  Suit trump = SPADES;
+  Card upcard;
+  Card discard;        // the dealer's discard when passes < 4
+  Card plays[PLAYS_PER_HAND]; // trick by trick, each from its leader
+};
+
+// A whole game. Players 0 and 2 are one team, players 1 and 3 the other.
+struct GameRecord {
+  int points_to_win = 0;
+  std::string names[4];
+  std::vector<HandRecord> hands;
+};
+
+//MODIFIES seats
+//EFFECTS Fills seats[i] with the seat that played hand.plays[i]
+void HandRecord_seats(const HandRecord &hand, int seats[PLAYS_PER_HAND]);
+
+//MODIFIES deal
+//EFFECTS Fills deal[seat] with the five cards dealt to each seat, in the
+//  order they were played
+void HandRecord_deal(const HandRecord &hand,
+                     Card deal[4][Player::MAX_HAND_SIZE]);
+
+//EFFECTS Returns the position at the first lead of hand, for solving
+SolverPosition HandRecord_position(const HandRecord &hand);
+
+//EFFECTS Writes the narration Game::play would have written for game, at
+//  the log's level
+void GameRecord_narrate(const GameRecord &game, GameLog &log);
+
+// Writes game records to a binary stream. The stream starts with the
+// bytes "EUCR" and a version byte. Each game is the byte 'G', points to
+// win, then each name as a length byte and its characters. Each hand
+// follows in 23 bytes: a bid byte (dealer in bits 0-1, passes in bits
+// 2-4, trump in bits 5-6, bit 7 set on the last hand of the game), then
+// the upcard, the discard and the 20 plays, one Card_index byte per card.
+class GameRecordWriter {
+public:
+  // EFFECTS: Writes the stream header to os
+  explicit GameRecordWriter(std::ostream &os);
+
+  // REQUIRES: game has at least one hand, points_to_win < 256 and names
+  //           shorter than 256 characters
+  // EFFECTS: Appends game to the stream
+  void write(const GameRecord &game);
+
+private:
+  std::ostream &os;
+  std::string buffer;
+};
+
+// Reads game records written by GameRecordWriter, one game at a time
+class GameRecordReader {
+public:
+  // EFFECTS: Reads the stream header from is
+  explicit GameRecordReader(std::istream &is);
+
+  // MODIFIES: game
+  // EFFECTS: Reads the next game into game, reusing its storage. Returns
+  //          false at the end of the stream or if the stream is not a
+  //          valid record.
+  bool read(GameRecord &game);
+
+private:
+  std::istream &is;
+  bool valid;
+
+  bool read_hand(HandRecord &hand, bool &last);
+};
+
+#endif // GAMERECORD_HPP
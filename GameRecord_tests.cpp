@@ -0,0 +1,146 @@
+#include "GameRecord.hpp"
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+static vector<pair<string, string>> simple_players() {
+    return {{"Edsger", "Simple"}, {"Fran", "Simple"},
+            {"Gabriel", "Simple"}, {"Herb", "Simple"}};
+}
+
+// EFFECTS: Plays a 10 point shuffled game, recording it and its full log
+static GameRecord play_recorded(string &text) {
+    Game game(Pack(), 10, true, simple_players());
+    GameRecord record;
+    ostringstream os;
+    {
+        GameLog log(os, LOG_FULL);
+        game.play(log, &record);
+    }
+    text = os.str();
+    return record;
+}
+
+static bool same_hand(const HandRecord &a, const HandRecord &b) {
+    return a.dealer == b.dealer && a.passes == b.passes &&
+           a.trump == b.trump && a.upcard == b.upcard &&
+           a.discard == b.discard && equal(a.plays, a.plays + PLAYS_PER_HAND,
+                                           b.plays);
+}
+
+TEST(test_record_round_trip) {
+    string text;
+    GameRecord record = play_recorded(text);
+
+    stringstream stream;
+    GameRecordWriter writer(stream);
+    writer.write(record);
+    writer.write(record);
+    // a magic number, then the game header and 23 bytes per hand, twice
+    size_t game_size = 2 + 4 + 6 + 4 + 7 + 4 + 23 * record.hands.size();
+    ASSERT_EQUAL(stream.str().size(), 5 + 2 * game_size);
+
+    GameRecordReader reader(stream);
+    GameRecord copy;
+    for (int n = 0; n < 2; ++n) {
+        ASSERT_TRUE(reader.read(copy));
+        ASSERT_EQUAL(copy.points_to_win, 10);
+        ASSERT_EQUAL(copy.names[3], "Herb");
+        ASSERT_EQUAL(copy.hands.size(), record.hands.size());
+        for (size_t i = 0; i < record.hands.size(); ++i) {
+            ASSERT_TRUE(same_hand(copy.hands[i], record.hands[i]));
+        }
+    }
+    ASSERT_FALSE(reader.read(copy));
+}
+
+// Narrating a record gives exactly the text the game wrote as it played
+TEST(test_record_narrate_matches_game) {
+    string text;
+    GameRecord record = play_recorded(text);
+
+    ostringstream os;
+    {
+        GameLog log(os, LOG_FULL);
+        GameRecord_narrate(record, log);
+    }
+    ASSERT_EQUAL(os.str(), text);
+}
+
+// The first hand of an unshuffled pack, as in euchre_test00
+TEST(test_record_deal) {
+    Game game(Pack(), 1, false, simple_players());
+    GameRecord record;
+    GameLog log(cout, LOG_NONE);
+    game.play(log, &record);
+
+    const HandRecord &hand = record.hands[0];
+    ASSERT_EQUAL(hand.dealer, 0);
+    ASSERT_EQUAL(hand.upcard, Card(JACK, DIAMONDS));
+    ASSERT_EQUAL(hand.passes, 4);
+    ASSERT_EQUAL(hand.trump, HEARTS);
+
+    Card deal[4][Player::MAX_HAND_SIZE];
+    HandRecord_deal(hand, deal);
+    sort(deal[1], deal[1] + Player::MAX_HAND_SIZE);
+    Card expected[] = {Card(NINE, SPADES), Card(TEN, SPADES), Card(JACK, SPADES),
+                       Card(KING, HEARTS), Card(ACE, HEARTS)};
+    sort(expected, expected + Player::MAX_HAND_SIZE);
+    ASSERT_TRUE(equal(expected, expected + Player::MAX_HAND_SIZE, deal[1]));
+}
+
+// When the dealer picks up, the discard takes the upcard's place in the deal
+TEST(test_record_deal_with_discard) {
+    HandRecord hand;
+    hand.dealer = 3;
+    hand.passes = 0;
+    hand.trump = SPADES;
+    hand.upcard = Card(ACE, SPADES);
+    hand.discard = Card(NINE, HEARTS);
+    // the dealer wins the first trick with the upcard and leads the rest
+    for (int trick = 0; trick < 5; ++trick) {
+        for (int i = 0; i < TRICK_SIZE; ++i) {
+            hand.plays[trick * TRICK_SIZE + i] =
+                Card(static_cast<Rank>(TWO + trick), static_cast<Suit>(i));
+        }
+    }
+    hand.plays[0] = Card(KING, DIAMONDS);
+    hand.plays[3] = Card(ACE, SPADES);
+
+    int seats[PLAYS_PER_HAND];
+    HandRecord_seats(hand, seats);
+    ASSERT_EQUAL(seats[0], 0);
+    ASSERT_EQUAL(seats[3], 3);
+    ASSERT_EQUAL(seats[4], 3);
+
+    Card deal[4][Player::MAX_HAND_SIZE];
+    HandRecord_deal(hand, deal);
+    ASSERT_EQUAL(deal[0][0], Card(KING, DIAMONDS));
+    ASSERT_EQUAL(deal[3][0], Card(NINE, HEARTS));
+}
+
+TEST(test_record_reader_rejects_bad_input) {
+    istringstream bad_magic("EUCX\x01G");
+    GameRecordReader reader(bad_magic);
+    GameRecord game;
+    ASSERT_FALSE(reader.read(game));
+
+    string text;
+    stringstream stream;
+    GameRecordWriter writer(stream);
+    writer.write(play_recorded(text));
+    string truncated = stream.str();
+    truncated.pop_back();
+    istringstream short_stream(truncated);
+    GameRecordReader short_reader(short_stream);
+    ASSERT_FALSE(short_reader.read(game));
+}
+
+TEST_MAIN()
@@ -0,0 +1,291 @@
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Every allocation the tests make, counted so that tests can check that a
+// reused game allocates nothing
+static atomic<long long> allocations(0);
+
+void * operator new(size_t size) {
+    ++allocations;
+    if (void *p = malloc(size)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+static vector<pair<string, string>> simple_players() {
+    return {{"Adi", "Simple"}, {"Barbara", "Simple"},
+            {"Chi-Chih", "Simple"}, {"Dabbala", "Simple"}};
+}
+
+// Matches euchre_test00: one hand, Adi and Chi-Chih euchre the makers
+TEST(test_game_play_quiet_noshuffle) {
+    Game game(Pack(), 1, false, simple_players());
+    GameResult result = game.play(false);
+    ASSERT_EQUAL(result.winning_team, 0);
+    ASSERT_EQUAL(result.hands, 1);
+    ASSERT_EQUAL(result.euchres, 1);
+    ASSERT_EQUAL(result.marches, 0);
+}
+
+// A quiet game reaches the same result as a narrated one
+TEST(test_game_play_quiet_matches_narrated) {
+    Game loud(Pack(), 10, true, simple_players());
+    Game quiet(Pack(), 10, true, simple_players());
+
+    streambuf *old = cout.rdbuf(nullptr);
+    GameResult loud_result = loud.play(true);
+    cout.rdbuf(old);
+    GameResult quiet_result = quiet.play(false);
+
+    ASSERT_EQUAL(loud_result.winning_team, quiet_result.winning_team);
+    ASSERT_EQUAL(loud_result.hands, quiet_result.hands);
+    ASSERT_EQUAL(loud_result.euchres, quiet_result.euchres);
+    ASSERT_EQUAL(loud_result.marches, quiet_result.marches);
+}
+
+// The summary log keeps bids and results but not deals or tricks
+TEST(test_game_play_summary_log) {
+    Game game(Pack(), 1, false, simple_players());
+    ostringstream os;
+    {
+        GameLog log(os, LOG_SUMMARY);
+        game.play(log);
+    }
+    ASSERT_EQUAL(os.str(), "Hand 0\n"
+                           "Barbara orders up Hearts\n"
+                           "Adi and Chi-Chih win the hand\n"
+                           "euchred!\n"
+                           "Adi and Chi-Chih have 2 points\n"
+                           "Barbara and Dabbala have 0 points\n"
+                           "Adi and Chi-Chih win!\n");
+}
+
+// Monte Carlo players sample from their own seeded generators, so the same
+// game plays out the same way twice
+TEST(test_game_monte_carlo_repeatable) {
+    vector<pair<string, string>> players = {
+        {"Adi", "MonteCarlo:10"}, {"Barbara", "Simple"},
+        {"Chi-Chih", "MonteCarlo:10"}, {"Dabbala", "Simple"}};
+    ostringstream first_os;
+    ostringstream second_os;
+    {
+        Game first(Pack(), 5, true, players);
+        GameLog first_log(first_os, LOG_FULL);
+        first.play(first_log);
+        Game second(Pack(), 5, true, players);
+        GameLog second_log(second_os, LOG_FULL);
+        second.play(second_log);
+    }
+    ASSERT_FALSE(first_os.str().empty());
+    ASSERT_EQUAL(first_os.str(), second_os.str());
+}
+
+// With a corpus, hand k is dealt from pack first + k, wrapping around
+TEST(test_game_deals_from_corpus) {
+    const string filename = "Game_tests_corpus.tmp";
+    vector<array<Card, Pack::PACK_SIZE>> packs(3);
+    {
+        ofstream fout(filename, ios::binary);
+        PackCorpusWriter writer(fout);
+        for (int n = 0; n < 3; ++n) {
+            Pack pack;
+            Rng rng(7, n);
+            pack.shuffle(rng);
+            for (Card &card : packs[n]) {
+                card = pack.deal_one();
+            }
+            writer.write(packs[n]);
+        }
+    }
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open(filename));
+    remove(filename.c_str());
+
+    Game game(Pack(), 10, false, simple_players());
+    game.use_corpus(&corpus, 2);
+    ostringstream os;
+    GameRecord record;
+    {
+        GameLog log(os, LOG_NONE);
+        game.play(log, &record);
+    }
+    ASSERT_TRUE(record.hands.size() > 3);
+    for (size_t k = 0; k < record.hands.size(); ++k) {
+        // Twenty cards are dealt before the upcard
+        ASSERT_EQUAL(record.hands[k].upcard, packs[(2 + k) % 3][20]);
+    }
+}
+
+// Games that start max_hands_per_game packs apart deal different packs
+TEST(test_games_deal_disjoint_corpus_packs) {
+    const string filename = "Game_tests_disjoint.tmp";
+    const int points_to_win = 3;
+    const int stride = max_hands_per_game(points_to_win);
+    vector<array<Card, Pack::PACK_SIZE>> packs(2 * stride);
+    {
+        ofstream fout(filename, ios::binary);
+        PackCorpusWriter writer(fout);
+        for (int n = 0; n < 2 * stride; ++n) {
+            Pack pack;
+            Rng rng(9, n);
+            pack.shuffle(rng);
+            for (Card &card : packs[n]) {
+                card = pack.deal_one();
+            }
+            writer.write(packs[n]);
+        }
+    }
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open(filename));
+    remove(filename.c_str());
+
+    Game game(Pack(), points_to_win, false, simple_players());
+    for (int index = 0; index < 2; ++index) {
+        game.reset();
+        game.use_corpus(&corpus, index * stride);
+        ostringstream os;
+        GameRecord record;
+        GameLog log(os, LOG_NONE);
+        game.play(log, &record);
+        ASSERT_TRUE(record.hands.size() <= static_cast<size_t>(stride));
+        for (size_t k = 0; k < record.hands.size(); ++k) {
+            ASSERT_EQUAL(record.hands[k].upcard, packs[index * stride + k][20]);
+        }
+    }
+}
+
+// Players with the same strategy take the same tricks from the same cards,
+// so with the teams' seats swapped the other team scores the same points
+TEST(test_game_play_board_swapped) {
+    vector<pair<string, string>> players = simple_players();
+    vector<pair<string, string>> swapped = {players[1], players[0],
+                                            players[3], players[2]};
+    for (int board = 0; board < 8; ++board) {
+        Game first(Pack(), 10, true, players);
+        first.use_random_shuffle(Rng(11, board));
+        Game second(Pack(), 10, true, swapped);
+        second.use_random_shuffle(Rng(11, board));
+        GameLog log(cout, LOG_NONE);
+        HandScore first_score = first.play_board(board % 4, log);
+        HandScore second_score = second.play_board(board % 4, log);
+        ASSERT_EQUAL(HandScore_net(first_score), HandScore_net(second_score));
+    }
+}
+
+TEST(test_duplicate_stats) {
+    DuplicateStats stats;
+    stats.add(2, -1);
+    DuplicateStats other;
+    other.add(-1, 2);
+    other.add(1, 2);
+    stats.merge(other);
+    ASSERT_EQUAL(stats.boards, 3);
+    // Board scores 1, 1 and 3
+    ASSERT_ALMOST_EQUAL(stats.mean(), 5.0 / 3, 1e-9);
+    ASSERT_ALMOST_EQUAL(stats.standard_error(), sqrt(4.0 / 3 / 3), 1e-9);
+    // Six hands with mean 5 / 6 and squares summing to 15
+    double hand_variance = (15 - 6 * 25.0 / 36) / 5;
+    ASSERT_ALMOST_EQUAL(stats.independent_error(),
+                        sqrt(2 * hand_variance / 3), 1e-9);
+}
+
+// A reset game plays exactly as a new game would
+TEST(test_game_reset_matches_new_game) {
+    vector<pair<string, string>> players = {
+        {"Adi", "MonteCarlo:5"}, {"Barbara", "Simple"},
+        {"Chi-Chih", "Table"}, {"Dabbala", "Simple"}};
+    Game reused(Pack(), 5, true, players);
+    for (int game_index = 0; game_index < 3; ++game_index) {
+        Game fresh(Pack(), 5, true, players);
+        ostringstream fresh_os;
+        ostringstream reused_os;
+        if (game_index == 2) {
+            // Without a generator both shuffle from the pack as given
+            reused.reset();
+        } else {
+            fresh.use_random_shuffle(Rng(9, game_index));
+            reused.reset(Rng(9, game_index));
+        }
+        {
+            GameLog fresh_log(fresh_os, LOG_FULL);
+            fresh.play(fresh_log);
+            GameLog reused_log(reused_os, LOG_FULL);
+            reused.play(reused_log);
+        }
+        ASSERT_EQUAL(reused_os.str(), fresh_os.str());
+    }
+}
+
+// After its first game, a reused game of Simple and Table players plays
+// without allocating
+TEST(test_game_reset_does_not_allocate) {
+    vector<pair<string, string>> players = {
+        {"Adi", "Simple"}, {"Barbara", "Table"},
+        {"Chi-Chih", "Simple"}, {"Dabbala", "Table"}};
+    long long at_start = allocations;
+    Game game(Pack(), 10, true, players);
+    ASSERT_TRUE(allocations > at_start);
+    GameLog log(cout, LOG_NONE);
+    game.reset(Rng(4));
+    game.play(log);
+
+    long long before = allocations;
+    long long hands = 0;
+    for (int game_index = 0; game_index < 100; ++game_index) {
+        game.reset(Rng(4, game_index));
+        hands += game.play(log).hands;
+    }
+    ASSERT_EQUAL(allocations - before, 0);
+    ASSERT_TRUE(hands > 100);
+}
+
+TEST(test_sim_stats_add_and_merge) {
+    GameResult r1;
+    r1.winning_team = 0;
+    r1.hands = 8;
+    r1.euchres = 1;
+    r1.marches = 2;
+    GameResult r2;
+    r2.winning_team = 1;
+    r2.hands = 6;
+
+    SimStats a;
+    a.add(r1);
+    SimStats b;
+    b.add(r2);
+    b.add(r1);
+    a.merge(b);
+
+    ASSERT_EQUAL(a.games, 3);
+    ASSERT_EQUAL(a.team_wins[0], 2);
+    ASSERT_EQUAL(a.team_wins[1], 1);
+    ASSERT_EQUAL(a.hands, 22);
+    ASSERT_EQUAL(a.euchres, 2);
+    ASSERT_EQUAL(a.marches, 4);
+}
+
+TEST_MAIN()
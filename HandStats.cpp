@@ -0,0 +1,198 @@
+#include "HandStats.hpp"
+#include "Game.hpp"
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+// Shards publish HandStats a word at a time
+static_assert(is_trivially_copyable<HandStats>::value &&
+              sizeof(HandStats) % sizeof(long long) == 0,
+              "HandStats must be made of long long words");
+
+void HandStats::add(const HandScore &score, int dealer, int team1_tricks) {
+  int winners = score.winning_team;
+  // The makers won unless they were euchred
+  int makers = score.euchred ? 1 - winners : winners;
+  int team_tricks[2] = {team1_tricks, Player::MAX_HAND_SIZE - team1_tricks};
+  hands++;
+  euchres += score.euchred;
+  marches += score.march;
+  tricks[0] += team_tricks[0];
+  tricks[1] += team_tricks[1];
+  wins_by_dealer[dealer][winners]++;
+  points[winners][score.points]++;
+  points[1 - winners][0]++;
+  maker_tricks[team_tricks[makers]]++;
+}
+
+// Every field is a count, so totals merge word by word
+void HandStats::merge(const HandStats &other) {
+  long long words[sizeof(HandStats) / sizeof(long long)];
+  long long other_words[sizeof(HandStats) / sizeof(long long)];
+  memcpy(words, this, sizeof(words));
+  memcpy(other_words, &other, sizeof(other_words));
+  for (size_t i = 0; i < sizeof(words) / sizeof(long long); ++i) {
+    words[i] += other_words[i];
+  }
+  memcpy(this, words, sizeof(words));
+}
+
+// Only the writer changes sequence, so it can be read and written back
+// without a read-modify-write instruction. The release fence keeps the
+// odd sequence number ahead of the new words, and the release store keeps
+// the new words ahead of the even one.
+void StatsShard::add(const HandScore &score, int dealer, int team1_tricks) {
+  own.add(score, dealer, team1_tricks);
+  long long words[NUM_WORDS];
+  memcpy(words, &own, sizeof(words));
+
+  uint32_t start = sequence.load(memory_order_relaxed);
+  sequence.store(start + 1, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  for (int i = 0; i < NUM_WORDS; ++i) {
+    published[i].store(words[i], memory_order_relaxed);
+  }
+  sequence.store(start + 2, memory_order_release);
+}
+
+HandStats StatsShard::read() const {
+  long long words[NUM_WORDS];
+  uint32_t start = 0;
+  uint32_t end = 0;
+  do {
+    start = sequence.load(memory_order_acquire);
+    for (int i = 0; i < NUM_WORDS; ++i) {
+      words[i] = published[i].load(memory_order_relaxed);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    end = sequence.load(memory_order_relaxed);
+  } while (start % 2 != 0 || start != end);
+
+  HandStats stats;
+  memcpy(&stats, words, sizeof(words));
+  return stats;
+}
+
+StatsCollector::StatsCollector(int num_shards_in) :
+  num_shards(num_shards_in), shards(new PaddedShard[num_shards_in]) {
+  assert(num_shards >= 1);
+}
+
+StatsShard * StatsCollector::claim() {
+  int index = claimed.fetch_add(1);
+  assert(index < num_shards);
+  return &shards[index].shard;
+}
+
+HandStats StatsCollector::snapshot() const {
+  HandStats total;
+  for (int i = 0; i < num_shards; ++i) {
+    total.merge(shards[i].shard.read());
+  }
+  return total;
+}
+
+StatsFormat StatsFormat_of_path(const string &path) {
+  const string json = ".json";
+  bool is_json = path.size() >= json.size() &&
+                 path.compare(path.size() - json.size(), json.size(), json) == 0;
+  return is_json ? STATS_JSON : STATS_CSV;
+}
+
+// Team columns are numbered from 1, as in SimStats' output
+static void write_csv_header(ostream &os) {
+  os << "seconds,hands,euchres,marches,tricks_team1,tricks_team2";
+  for (int dealer = 0; dealer < 4; ++dealer) {
+    for (int team = 0; team < 2; ++team) {
+      os << ",wins_dealer" << dealer << "_team" << team + 1;
+    }
+  }
+  for (int team = 0; team < 2; ++team) {
+    for (int p = 0; p <= MAX_HAND_POINTS; ++p) {
+      os << ",points_team" << team + 1 << "_" << p;
+    }
+  }
+  for (int t = 0; t <= Player::MAX_HAND_SIZE; ++t) {
+    os << ",maker_tricks_" << t;
+  }
+  os << '\n';
+}
+
+static void write_csv_row(ostream &os, const HandStats &stats, double seconds) {
+  os << seconds << ',' << stats.hands << ',' << stats.euchres << ','
+     << stats.marches << ',' << stats.tricks[0] << ',' << stats.tricks[1];
+  for (const long long (&wins)[2] : stats.wins_by_dealer) {
+    os << ',' << wins[0] << ',' << wins[1];
+  }
+  for (const long long (&team_points)[MAX_HAND_POINTS + 1] : stats.points) {
+    for (long long count : team_points) {
+      os << ',' << count;
+    }
+  }
+  for (long long count : stats.maker_tricks) {
+    os << ',' << count;
+  }
+  os << '\n';
+}
+
+// EFFECTS: Writes counts as a JSON array
+template <size_t N>
+static void write_json_array(ostream &os, const long long (&counts)[N]) {
+  os << '[';
+  for (size_t i = 0; i < N; ++i) {
+    os << (i > 0 ? ", " : "") << counts[i];
+  }
+  os << ']';
+}
+
+// EFFECTS: Writes rows as a JSON array of arrays
+template <size_t M, size_t N>
+static void write_json_array(ostream &os, const long long (&rows)[M][N]) {
+  os << '[';
+  for (size_t i = 0; i < M; ++i) {
+    os << (i > 0 ? ", " : "");
+    write_json_array(os, rows[i]);
+  }
+  os << ']';
+}
+
+static void write_json_object(ostream &os, const HandStats &stats,
+                              double seconds) {
+  os << "  {\"seconds\": " << seconds << ", \"hands\": " << stats.hands
+     << ", \"euchres\": " << stats.euchres
+     << ", \"marches\": " << stats.marches << ",\n   \"tricks\": ";
+  write_json_array(os, stats.tricks);
+  os << ",\n   \"wins_by_dealer\": ";
+  write_json_array(os, stats.wins_by_dealer);
+  os << ",\n   \"points\": ";
+  write_json_array(os, stats.points);
+  os << ",\n   \"maker_tricks\": ";
+  write_json_array(os, stats.maker_tricks);
+  os << '}';
+}
+
+StatsWriter::StatsWriter(ostream &os_in, StatsFormat format_in) :
+  os(os_in), format(format_in), written(0) {}
+
+void StatsWriter::write(const HandStats &stats, double seconds) {
+  if (format == STATS_CSV) {
+    if (written == 0) {
+      write_csv_header(os);
+    }
+    write_csv_row(os, stats, seconds);
+  } else {
+    os << (written == 0 ? "[\n" : ",\n");
+    write_json_object(os, stats, seconds);
+  }
+  written++;
+  os.flush();
+}
+
+void StatsWriter::finish() {
+  if (format == STATS_JSON) {
+    os << (written == 0 ? "[" : "\n") << "]\n";
+  }
+  os.flush();
+}
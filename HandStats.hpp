@@ -0,0 +1,124 @@
+#ifndef HANDSTATS_HPP
+#define HANDSTATS_HPP
+/* HandStats.hpp
+ *
+ * Hand by hand statistics gathered from many threads at once
+ */
+
+#include "Card.hpp"
+#include "Player.hpp"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+
+struct HandScore;
+
+// Most points one team can win in a hand
+const int MAX_HAND_POINTS = 2;
+
+// Totals over every hand played. Players 0 and 2 are team 0, players 1
+// and 3 team 1.
+struct HandStats {
+  long long hands = 0;
+  long long euchres = 0;
+  long long marches = 0;
+  long long tricks[2] = {0, 0}; // taken by each team
+  // [dealer][team]: hands each team won, by the seat of the dealer
+  long long wins_by_dealer[4][2] = {};
+  // [team][p]: hands in which each team won p points
+  long long points[2][MAX_HAND_POINTS + 1] = {};
+  // [t]: hands in which the makers took t tricks
+  long long maker_tricks[Player::MAX_HAND_SIZE + 1] = {};
+
+  //EFFECTS adds a hand dealt by seat dealer, scored as score, in which
+  //  players 0 and 2 took team1_tricks tricks
+  void add(const HandScore &score, int dealer, int team1_tricks);
+
+  //EFFECTS adds other's totals to these totals
+  void merge(const HandStats &other);
+};
+
+// One thread's share of a StatsCollector. Only one thread may add hands to
+// a shard, but any thread may read it while hands are being added. A read
+// never waits for the writer, which never waits at all: the writer marks
+// the shard as changing by making its sequence number odd, and a reader
+// that sees the number odd, or changed by the end of its read, reads
+// again.
+class StatsShard {
+public:
+  // REQUIRES: only one thread ever calls add on this shard
+  // EFFECTS: Adds a hand, as HandStats::add does
+  void add(const HandScore &score, int dealer, int team1_tricks);
+
+  // EFFECTS: Returns the hands added so far. Safe to call from any thread.
+  HandStats read() const;
+
+private:
+  static const int NUM_WORDS = sizeof(HandStats) / sizeof(long long);
+
+  HandStats own; // the writer's copy, only touched by the writer
+  std::atomic<uint32_t> sequence{0};
+  std::atomic<long long> published[NUM_WORDS] = {};
+};
+
+// Hand statistics of a run on many threads. Each thread adds to its own
+// shard, so threads never contend on a shared counter, and the shards are
+// summed on demand: a snapshot can be taken at any time while the run is
+// in progress, and each shard in it is as of the end of some hand.
+class StatsCollector {
+public:
+  // REQUIRES: num_shards >= 1
+  // EFFECTS: Creates a collector with room for num_shards threads
+  explicit StatsCollector(int num_shards);
+
+  // REQUIRES: fewer than num_shards shards have been claimed
+  // EFFECTS: Returns a shard no other caller has been given, for the
+  //          calling thread to add its hands to
+  StatsShard * claim();
+
+  // EFFECTS: Returns the sum of every shard. Safe to call from any thread.
+  HandStats snapshot() const;
+
+private:
+  // Each shard is written by a different thread, so shards are kept on
+  // different cache lines
+  struct alignas(64) PaddedShard {
+    StatsShard shard;
+  };
+
+  int num_shards;
+  std::unique_ptr<PaddedShard[]> shards;
+  std::atomic<int> claimed{0};
+};
+
+// File formats HandStats can be written in
+enum StatsFormat {
+  STATS_CSV,  // a header line, then one line per snapshot
+  STATS_JSON  // an array with one object per snapshot
+};
+
+//EFFECTS Returns STATS_JSON if path ends in ".json", otherwise STATS_CSV
+StatsFormat StatsFormat_of_path(const std::string &path);
+
+// Writes a series of snapshots, each stamped with the seconds since the
+// run started. Histograms are columns such as points_team1_2 in CSV and
+// nested arrays in JSON.
+class StatsWriter {
+public:
+  StatsWriter(std::ostream &os, StatsFormat format);
+
+  // EFFECTS: Appends stats, taken seconds into the run, to the stream
+  void write(const HandStats &stats, double seconds);
+
+  // EFFECTS: Ends the stream. Nothing may be written after.
+  void finish();
+
+private:
+  std::ostream &os;
+  StatsFormat format;
+  int written;
+};
+
+#endif // HANDSTATS_HPP
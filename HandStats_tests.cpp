@@ -0,0 +1,176 @@
+#include "HandStats.hpp"
+#include "Game.hpp"
+#include "unit_test_framework.hpp"
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// EFFECTS: Returns true if the totals of stats agree with each other
+static bool consistent(const HandStats &stats) {
+    long long by_dealer = 0;
+    for (const long long (&wins)[2] : stats.wins_by_dealer) {
+        by_dealer += wins[0] + wins[1];
+    }
+    long long by_tricks = 0;
+    for (long long count : stats.maker_tricks) {
+        by_tricks += count;
+    }
+    long long team1_points = 0;
+    for (long long count : stats.points[0]) {
+        team1_points += count;
+    }
+    return by_dealer == stats.hands && by_tricks == stats.hands &&
+           team1_points == stats.hands &&
+           stats.tricks[0] + stats.tricks[1] ==
+               stats.hands * Player::MAX_HAND_SIZE &&
+           stats.euchres == stats.maker_tricks[0] + stats.maker_tricks[1] +
+                            stats.maker_tricks[2] &&
+           stats.marches == stats.maker_tricks[Player::MAX_HAND_SIZE];
+}
+
+// The makers are team 2 in both hands: once euchred, once taking three
+TEST(test_hand_stats_add) {
+    HandStats stats;
+    stats.add(score_hand(3, false), 1, 3);
+    stats.add(score_hand(2, false), 2, 2);
+    ASSERT_EQUAL(stats.hands, 2);
+    ASSERT_EQUAL(stats.euchres, 1);
+    ASSERT_EQUAL(stats.marches, 0);
+    ASSERT_EQUAL(stats.tricks[0], 5);
+    ASSERT_EQUAL(stats.tricks[1], 5);
+    ASSERT_EQUAL(stats.wins_by_dealer[1][0], 1);
+    ASSERT_EQUAL(stats.wins_by_dealer[2][1], 1);
+    ASSERT_EQUAL(stats.points[0][2], 1);
+    ASSERT_EQUAL(stats.points[0][0], 1);
+    ASSERT_EQUAL(stats.points[1][1], 1);
+    ASSERT_EQUAL(stats.points[1][0], 1);
+    ASSERT_EQUAL(stats.maker_tricks[2], 1);
+    ASSERT_EQUAL(stats.maker_tricks[3], 1);
+    ASSERT_TRUE(consistent(stats));
+
+    HandStats twice = stats;
+    twice.merge(stats);
+    ASSERT_EQUAL(twice.hands, 4);
+    ASSERT_EQUAL(twice.points[1][1], 2);
+    ASSERT_EQUAL(twice.maker_tricks[3], 2);
+}
+
+// A game adds every hand it plays, and keeps adding after reset
+TEST(test_hand_stats_from_game) {
+    StatsCollector collector(1);
+    vector<pair<string, string>> players = {
+        {"Adi", "Simple"}, {"Barbara", "Simple"},
+        {"Chi-Chih", "Simple"}, {"Dabbala", "Simple"}};
+    Game game(Pack(), 10, true, players);
+    game.use_stats(collector.claim());
+    long long hands = 0;
+    long long euchres = 0;
+    long long marches = 0;
+    for (int i = 0; i < 20; ++i) {
+        game.reset(Rng(5, i));
+        GameResult result = game.play(false);
+        hands += result.hands;
+        euchres += result.euchres;
+        marches += result.marches;
+    }
+    HandStats stats = collector.snapshot();
+    ASSERT_EQUAL(stats.hands, hands);
+    ASSERT_EQUAL(stats.euchres, euchres);
+    ASSERT_EQUAL(stats.marches, marches);
+    ASSERT_TRUE(consistent(stats));
+}
+
+// Snapshots taken while threads add hands see each shard as of the end of
+// some hand, and the last one sees every hand
+TEST(test_stats_collector_snapshot_while_running) {
+    const int num_threads = 4;
+    const int hands_per_thread = 20000;
+    StatsCollector collector(num_threads);
+    atomic<int> finished(0);
+    vector<thread> workers;
+    for (int t = 0; t < num_threads; ++t) {
+        workers.emplace_back([&collector, &finished, t]() {
+            StatsShard *shard = collector.claim();
+            for (int i = 0; i < hands_per_thread; ++i) {
+                int team1_tricks = (i + t) % 6;
+                shard->add(score_hand(team1_tricks, i % 2 == 0), i % 4,
+                           team1_tricks);
+            }
+            finished++;
+        });
+    }
+    long long last_hands = 0;
+    while (finished < num_threads) {
+        HandStats stats = collector.snapshot();
+        ASSERT_TRUE(consistent(stats));
+        ASSERT_TRUE(stats.hands >= last_hands);
+        last_hands = stats.hands;
+    }
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    HandStats stats = collector.snapshot();
+    ASSERT_EQUAL(stats.hands, num_threads * hands_per_thread);
+    ASSERT_TRUE(consistent(stats));
+}
+
+TEST(test_stats_format_of_path) {
+    ASSERT_EQUAL(StatsFormat_of_path("stats.json"), STATS_JSON);
+    ASSERT_EQUAL(StatsFormat_of_path("stats.csv"), STATS_CSV);
+    ASSERT_EQUAL(StatsFormat_of_path("json"), STATS_CSV);
+}
+
+TEST(test_stats_writer_csv) {
+    HandStats stats;
+    stats.add(score_hand(5, true), 0, 5);
+    ostringstream os;
+    StatsWriter writer(os, STATS_CSV);
+    writer.write(HandStats(), 0.5);
+    writer.write(stats, 1);
+    writer.finish();
+    istringstream lines(os.str());
+    string header;
+    string first;
+    string second;
+    getline(lines, header);
+    getline(lines, first);
+    getline(lines, second);
+    ASSERT_EQUAL(header.substr(0, 50),
+                 "seconds,hands,euchres,marches,tricks_team1,tricks_");
+    ASSERT_EQUAL(header.substr(header.size() - 15), ",maker_tricks_5");
+    ASSERT_EQUAL(first.substr(0, 12), "0.5,0,0,0,0,");
+    ASSERT_EQUAL(second, "1,1,0,1,5,0,1,0,0,0,0,0,0,0,0,0,1,1,0,0,"
+                         "0,0,0,0,0,1");
+    ASSERT_FALSE(getline(lines, header).good());
+}
+
+TEST(test_stats_writer_json) {
+    HandStats stats;
+    stats.add(score_hand(5, true), 0, 5);
+    ostringstream os;
+    StatsWriter writer(os, STATS_JSON);
+    writer.write(stats, 2);
+    writer.finish();
+    ASSERT_EQUAL(os.str(),
+                 "[\n"
+                 "  {\"seconds\": 2, \"hands\": 1, \"euchres\": 0, "
+                 "\"marches\": 1,\n"
+                 "   \"tricks\": [5, 0],\n"
+                 "   \"wins_by_dealer\": [[1, 0], [0, 0], [0, 0], [0, 0]],\n"
+                 "   \"points\": [[0, 0, 1], [1, 0, 0]],\n"
+                 "   \"maker_tricks\": [0, 0, 0, 0, 0, 1]}\n"
+                 "]\n");
+
+    ostringstream empty;
+    StatsWriter nothing(empty, STATS_JSON);
+    nothing.finish();
+    ASSERT_EQUAL(empty.str(), "[]\n");
+}
+
+TEST_MAIN()
@@ -3,6 +3,7 @@
 #include <array>
 #include <string>
 #include <iostream>
+#include <utility>
 
 using namespace std;
 
@@ -24,35 +25,47 @@ Pack::Pack(std::istream& pack_input) : next(0) {
     }
 } 
 
-Card Pack::deal_one() {
-    next++;
-    return cards[next-1];
-}
+Pack::Pack(const array<Card, PACK_SIZE> &cards_in) :
+    cards(cards_in), next(0) {}
 
 void Pack::reset() {
     next = 0;
 }
 
+// Seven in shuffles, worked out at compile time
+static constexpr Pack::Permutation SEVEN_IN_SHUFFLES =
+    Pack::shuffle_permutation(IN_SHUFFLE, 7);
+
 void Pack::shuffle() {
-    for (int shuffle_count = 0; shuffle_count < 7; shuffle_count++) {
-        array<Card, PACK_SIZE> shuffled;
+    permute(SEVEN_IN_SHUFFLES);
+}
 
-        array<Card, PACK_SIZE / 2> first_half;
-        array<Card, PACK_SIZE / 2> second_half;
+void Pack::shuffle(ShuffleType type, int count) {
+    assert(count >= 0);
+    permute(shuffle_permutation(type, count));
+}
 
-        for (int i = 0; i < PACK_SIZE / 2; i++) {
-            first_half[i] = cards[i];
-            second_half[i] = cards[i + PACK_SIZE / 2];
-        }
+// The Fisher-Yates loop written out, swapping slot PACK_SIZE - 1 - step
+// for each step in turn. Each rng.below then divides by a constant, which
+// compiles to a multiply instead of a division, and draws the same numbers.
+template <size_t... Steps>
+static void fisher_yates(array<Card, Pack::PACK_SIZE> &cards, Rng &rng,
+                         index_sequence<Steps...>) {
+    (swap(cards[Pack::PACK_SIZE - 1 - Steps],
+          cards[rng.below(Pack::PACK_SIZE - Steps)]), ...);
+}
 
-        for (int i = 0; i < PACK_SIZE / 2; i++) {
-            shuffled[2*i] = second_half[i];
-            shuffled[2*i+1] = first_half[i];
-        }
+void Pack::shuffle(Rng &rng) {
+    fisher_yates(cards, rng, make_index_sequence<PACK_SIZE - 1>());
+    next = 0;
+}
 
-        cards = shuffled;
+void Pack::permute(const Permutation &perm) {
+    array<Card, PACK_SIZE> shuffled;
+    for (int i = 0; i < PACK_SIZE; i++) {
+        shuffled[i] = cards[perm[i]];
     }
-
+    cards = shuffled;
     next = 0;
 }
 
@@ -10,9 +10,18 @@
 
 
 #include "Card.hpp"
+#include "Random.hpp"
 #include <array>
 #include <string>
 
+// The two perfect riffle shuffles. An in shuffle puts the top card of the
+// bottom half on top; an out shuffle keeps the top card on top.
+// See https://en.wikipedia.org/wiki/Faro_shuffle.
+enum ShuffleType {
+  IN_SHUFFLE,
+  OUT_SHUFFLE,
+};
+
 class Pack {
 public:
   // EFFECTS: Initializes the Pack to be in the following standard order:
@@ -43,13 +52,66 @@ public:
   //          https://en.wikipedia.org/wiki/In_shuffle.
   void shuffle();
 
+  // REQUIRES: count >= 0
+  // EFFECTS: Performs count perfect shuffles of the given type and resets
+  //          the next index. The combined permutation is applied in a
+  //          single pass.
+  void shuffle(ShuffleType type, int count);
+
+  // MODIFIES: rng
+  // EFFECTS: Shuffles the Pack uniformly at random with a Fisher-Yates
+  //          shuffle driven by rng, and resets the next index. See
+  //          https://en.wikipedia.org/wiki/Fisher%E2%80%93Yates_shuffle.
+  void shuffle(Rng &rng);
+
   // EFFECTS: returns true if there are no more cards left in the pack
   bool empty() const;
 
-private:
   static const int PACK_SIZE = 24;
+
+  // Source index of each slot after a shuffle: slot i takes the card that
+  // was at index permutation[i]
+  using Permutation = std::array<int, PACK_SIZE>;
+
+  // EFFECTS: Initializes the Pack to hold cards_in, with cards_in[0] on top
+  // NOTE: The pack is initially full, with no cards dealt.
+  explicit Pack(const std::array<Card, PACK_SIZE> &cards_in);
+
+  // REQUIRES: count >= 0
+  // EFFECTS: Returns the permutation made by count shuffles of the given
+  //          type. Usable in constant expressions.
+  static constexpr Permutation shuffle_permutation(ShuffleType type, int count) {
+    Permutation perm = {};
+    for (int i = 0; i < PACK_SIZE; ++i) {
+      perm[i] = i;
+    }
+    const int half = PACK_SIZE / 2;
+    for (int n = 0; n < count; ++n) {
+      Permutation shuffled = {};
+      for (int i = 0; i < half; ++i) {
+        int top = perm[i];
+        int bottom = perm[i + half];
+        shuffled[2*i] = (type == IN_SHUFFLE) ? bottom : top;
+        shuffled[2*i+1] = (type == IN_SHUFFLE) ? top : bottom;
+      }
+      perm = shuffled;
+    }
+    return perm;
+  }
+
+private:
   std::array<Card, PACK_SIZE> cards;
   int next; //index of next card to be dealt
+
+  // EFFECTS: Rearranges cards so slot i holds the card at perm[i], and
+  //          resets the next index
+  void permute(const Permutation &perm);
 };
 
+// Defined here so that dealing a hand, a card at a time, is inlined
+inline Card Pack::deal_one() {
+  next++;
+  return cards[next-1];
+}
+
 #endif // PACK_HPP
@@ -0,0 +1,177 @@
+#include "PackCorpus.hpp"
+#include "PackParser.hpp"
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PACKCORPUS_MMAP
+#endif
+
+using namespace std;
+
+static const char MAGIC[] = {'E', 'U', 'C', 'P'};
+static const char VERSION = 1;
+
+// The magic, the version and padding, so that packs start on 8 bytes
+static const size_t HEADER_SIZE = 8;
+
+PackCorpus::PackCorpus() :
+  data(nullptr), data_size(0), mapped(false), binary(false), count(0),
+  found(false) {}
+
+PackCorpus::~PackCorpus() {
+  close();
+}
+
+void PackCorpus::close() {
+#ifdef PACKCORPUS_MMAP
+  if (mapped) {
+    munmap(const_cast<char *>(data), data_size);
+  }
+#endif
+  data = nullptr;
+  data_size = 0;
+  mapped = false;
+  vector<char>().swap(buffer);
+  binary = false;
+  count = 0;
+  vector<size_t>().swap(text_offsets);
+}
+
+// Points data at the contents of filename: mapped where the system can map
+// files, and otherwise read into buffer
+bool PackCorpus::load(const string &filename) {
+#ifdef PACKCORPUS_MMAP
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+    void *address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address != MAP_FAILED) {
+      data = static_cast<const char *>(address);
+      data_size = info.st_size;
+      mapped = true;
+    }
+  }
+  ::close(fd);
+  if (mapped) {
+    return true;
+  }
+#endif
+  ifstream fin(filename, ios::binary);
+  if (!fin.is_open()) {
+    return false;
+  }
+  buffer.assign(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+  data = buffer.data();
+  data_size = buffer.size();
+  return true;
+}
+
+bool PackCorpus::open(const string &filename) {
+  close();
+  error.clear();
+  found = load(filename);
+  if (!found) {
+    error = "cannot open " + filename;
+    return false;
+  }
+  binary = data_size >= sizeof(MAGIC) &&
+           memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+  if (!(binary ? index_binary() : index_text())) {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// Checks the header and that every byte is a Card_index
+bool PackCorpus::index_binary() {
+  if (data_size < HEADER_SIZE || data[sizeof(MAGIC)] != VERSION) {
+    error = "not a version " + to_string(VERSION) + " binary corpus";
+    return false;
+  }
+  if ((data_size - HEADER_SIZE) % Pack::PACK_SIZE != 0) {
+    error = "binary corpus ends part way through a pack";
+    return false;
+  }
+  count = (data_size - HEADER_SIZE) / Pack::PACK_SIZE;
+  if (count == 0) {
+    error = "no cards";
+    return false;
+  }
+  const unsigned char *bytes = raw(0);
+  size_t num_bytes = data_size - HEADER_SIZE;
+  for (size_t i = 0; i < num_bytes; ++i) {
+    if (bytes[i] >= NUM_CARD_INDICES) {
+      error = "pack " + to_string(i / Pack::PACK_SIZE) +
+              " has a card out of range";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Parses every pack, recording where each one starts
+bool PackCorpus::index_text() {
+  PackParser parser(data, data_size);
+  array<Card, Pack::PACK_SIZE> cards;
+  while (!parser.done()) {
+    text_offsets.push_back(parser.get_next() - data);
+    if (!parser.next_pack(cards)) {
+      error = parser.get_error().message;
+      return false;
+    }
+  }
+  count = text_offsets.size();
+  if (count == 0) {
+    error = "no cards";
+    return false;
+  }
+  return true;
+}
+
+void PackCorpus::get(long long n, array<Card, Pack::PACK_SIZE> &cards) const {
+  assert(0 <= n && n < count);
+  if (binary) {
+    const unsigned char *bytes = raw(n);
+    for (int i = 0; i < Pack::PACK_SIZE; ++i) {
+      cards[i] = Card_from_index(bytes[i]);
+    }
+    return;
+  }
+  size_t offset = text_offsets[n];
+  PackParser parser(data + offset, data_size - offset);
+  bool parsed = parser.next_pack(cards);
+  assert(parsed);
+  (void)parsed;
+}
+
+const unsigned char * PackCorpus::raw(long long n) const {
+  assert(binary && 0 <= n && n < count);
+  return reinterpret_cast<const unsigned char *>(data + HEADER_SIZE) +
+         n * Pack::PACK_SIZE;
+}
+
+PackCorpusWriter::PackCorpusWriter(ostream &os) : os(os) {
+  char header[HEADER_SIZE] = {};
+  memcpy(header, MAGIC, sizeof(MAGIC));
+  header[sizeof(MAGIC)] = VERSION;
+  os.write(header, sizeof(header));
+}
+
+void PackCorpusWriter::write(const array<Card, Pack::PACK_SIZE> &cards) {
+  char bytes[Pack::PACK_SIZE];
+  for (int i = 0; i < Pack::PACK_SIZE; ++i) {
+    bytes[i] = static_cast<char>(Card_index(cards[i]));
+  }
+  os.write(bytes, sizeof(bytes));
+}
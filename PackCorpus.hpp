@@ -0,0 +1,100 @@
+#ifndef PACKCORPUS_HPP
+#define PACKCORPUS_HPP
+/* PackCorpus.hpp
+ *
+ * A file of many packs, for example recorded deals, read in place
+ */
+
+#include "Card.hpp"
+#include "Pack.hpp"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// A read-only corpus of packs, memory-mapped from a file so that millions
+// of packs cost no reading up front. The file is either text, packs in the
+// format of pack.in one after another, or binary, as written by
+// PackCorpusWriter.
+//
+// Binary packs are read straight from the mapping, 24 bytes each. Text is
+// parsed once when it is opened to find where each pack starts, and again
+// from the mapping when a pack is read. Once open, a corpus is never
+// changed, so any number of threads may read it at the same time.
+class PackCorpus {
+public:
+  // EFFECTS: Creates an empty corpus
+  PackCorpus();
+
+  // The mapping belongs to the corpus, so it cannot be copied
+  PackCorpus(const PackCorpus &) = delete;
+  PackCorpus & operator=(const PackCorpus &) = delete;
+
+  ~PackCorpus();
+
+  // MODIFIES: *this
+  // EFFECTS: Maps filename and checks every pack in it, replacing any
+  //          corpus opened before. Returns false if the file cannot be
+  //          opened, holds no packs or is malformed; get_error() then says
+  //          why and the corpus is empty.
+  bool open(const std::string &filename);
+
+  // EFFECTS: Returns true if open() last found the file, even if the
+  //          file turned out to be malformed
+  bool file_found() const { return found; }
+
+  // EFFECTS: Returns why open() last failed, for example
+  //          "line 3: expected a rank, found \"Nien\""
+  const std::string & get_error() const { return error; }
+
+  // EFFECTS: Returns true if the file opened is binary
+  bool is_binary() const { return binary; }
+
+  // EFFECTS: Returns the number of packs
+  long long size() const { return count; }
+
+  // REQUIRES: 0 <= n < size()
+  // MODIFIES: cards
+  // EFFECTS: Sets cards to pack n, cards[0] first
+  void get(long long n, std::array<Card, Pack::PACK_SIZE> &cards) const;
+
+  // REQUIRES: is_binary() and 0 <= n < size()
+  // EFFECTS: Returns the Card_index of each card of pack n, in the mapping
+  //          itself. The bytes stay valid until the corpus is closed.
+  const unsigned char * raw(long long n) const;
+
+private:
+  const char *data;        // the contents of the file
+  size_t data_size;
+  bool mapped;             // data was mapped, rather than read into buffer
+  std::vector<char> buffer;
+  bool binary;
+  long long count;
+  std::vector<size_t> text_offsets; // where each text pack starts
+  bool found;
+  std::string error;
+
+  void close();
+  bool load(const std::string &filename);
+  bool index_binary();
+  bool index_text();
+};
+
+// Writes packs as a binary corpus: a header, then the Card_index of each
+// card, one byte per card and 24 bytes per pack.
+class PackCorpusWriter {
+public:
+  // MODIFIES: os
+  // EFFECTS: Writes the header of a corpus to os
+  explicit PackCorpusWriter(std::ostream &os);
+
+  // MODIFIES: os
+  // EFFECTS: Appends cards to the corpus, cards[0] first
+  void write(const std::array<Card, Pack::PACK_SIZE> &cards);
+
+private:
+  std::ostream &os;
+};
+
+#endif // PACKCORPUS_HPP
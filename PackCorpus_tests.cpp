@@ -0,0 +1,153 @@
+#include "PackCorpus.hpp"
+#include "unit_test_framework.hpp"
+
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+using Cards = array<Card, Pack::PACK_SIZE>;
+
+static const string FILENAME = "PackCorpus_tests.tmp";
+
+// EFFECTS: Returns count packs, each shuffled with its own generator
+static vector<Cards> shuffled_packs(int count) {
+    vector<Cards> packs(count);
+    for (int n = 0; n < count; ++n) {
+        Pack pack;
+        Rng rng(280, n);
+        pack.shuffle(rng);
+        for (Card &card : packs[n]) {
+            card = pack.deal_one();
+        }
+    }
+    return packs;
+}
+
+// EFFECTS: Replaces the contents of FILENAME with contents
+static void write_file(const string &contents) {
+    ofstream fout(FILENAME, ios::binary);
+    fout << contents;
+}
+
+// EFFECTS: Returns packs in the format of pack.in, one after another
+static string text_of(const vector<Cards> &packs) {
+    ostringstream os;
+    for (const Cards &cards : packs) {
+        for (const Card &card : cards) {
+            os << card << '\n';
+        }
+        os << '\n';
+    }
+    return os.str();
+}
+
+// EFFECTS: Returns packs as a binary corpus
+static string binary_of(const vector<Cards> &packs) {
+    ostringstream os;
+    PackCorpusWriter writer(os);
+    for (const Cards &cards : packs) {
+        writer.write(cards);
+    }
+    return os.str();
+}
+
+// EFFECTS: Returns the error from opening contents as a corpus
+static string open_error(const string &contents) {
+    write_file(contents);
+    PackCorpus corpus;
+    bool opened = corpus.open(FILENAME);
+    remove(FILENAME.c_str());
+    return opened ? "" : corpus.get_error();
+}
+
+TEST(test_corpus_text) {
+    vector<Cards> packs = shuffled_packs(3);
+    write_file(text_of(packs));
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open(FILENAME));
+    remove(FILENAME.c_str());
+    ASSERT_FALSE(corpus.is_binary());
+    ASSERT_EQUAL(corpus.size(), 3);
+    Cards cards;
+    for (int n : {2, 0, 1}) {
+        corpus.get(n, cards);
+        ASSERT_TRUE(cards == packs[n]);
+    }
+}
+
+// pack.in is a corpus of one pack
+TEST(test_corpus_pack_in) {
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open("pack.in"));
+    ASSERT_EQUAL(corpus.size(), 1);
+    Cards cards;
+    corpus.get(0, cards);
+    Pack expected;
+    for (const Card &card : cards) {
+        ASSERT_EQUAL(card, expected.deal_one());
+    }
+}
+
+TEST(test_corpus_binary) {
+    vector<Cards> packs = shuffled_packs(5);
+    write_file(binary_of(packs));
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open(FILENAME));
+    remove(FILENAME.c_str());
+    ASSERT_TRUE(corpus.is_binary());
+    ASSERT_EQUAL(corpus.size(), 5);
+    Cards cards;
+    for (int n = 4; n >= 0; --n) {
+        corpus.get(n, cards);
+        ASSERT_TRUE(cards == packs[n]);
+        const unsigned char *bytes = corpus.raw(n);
+        for (int i = 0; i < Pack::PACK_SIZE; ++i) {
+            ASSERT_EQUAL(int(bytes[i]), Card_index(packs[n][i]));
+        }
+    }
+}
+
+// Opening another file replaces the corpus, and a failure leaves it empty
+TEST(test_corpus_reopen) {
+    PackCorpus corpus;
+    ASSERT_TRUE(corpus.open("pack.in"));
+    write_file(binary_of(shuffled_packs(2)));
+    ASSERT_TRUE(corpus.open(FILENAME));
+    ASSERT_EQUAL(corpus.size(), 2);
+    remove(FILENAME.c_str());
+
+    ASSERT_FALSE(corpus.open(FILENAME));
+    ASSERT_FALSE(corpus.file_found());
+    ASSERT_EQUAL(corpus.size(), 0);
+    ASSERT_EQUAL(corpus.get_error(), "cannot open " + FILENAME);
+    ASSERT_TRUE(corpus.open("pack.in"));
+    ASSERT_TRUE(corpus.file_found());
+}
+
+TEST(test_corpus_errors) {
+    ASSERT_EQUAL(open_error(""), "no cards");
+    ASSERT_EQUAL(open_error(" \n\n"), "no cards");
+    ASSERT_EQUAL(open_error("Nine of Spades\nTen of Spadse\n"),
+                 "line 2: expected a suit, found \"Spadse\"");
+    // Without the last card
+    string text = text_of(shuffled_packs(2));
+    text.erase(text.rfind('\n', text.size() - 3) + 1);
+    ASSERT_EQUAL(open_error(text), "line 49: pack ends after 23 of 24 cards");
+
+    string binary = binary_of(shuffled_packs(2));
+    ASSERT_EQUAL(open_error(binary.substr(0, 8)), "no cards");
+    ASSERT_EQUAL(open_error(binary.substr(0, binary.size() - 1)),
+                 "binary corpus ends part way through a pack");
+    string wrong_version = binary;
+    wrong_version[4] = 2;
+    ASSERT_EQUAL(open_error(wrong_version), "not a version 1 binary corpus");
+    binary[8 + 30] = 52;
+    ASSERT_EQUAL(open_error(binary), "pack 1 has a card out of range");
+}
+
+TEST_MAIN()
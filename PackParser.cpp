@@ -0,0 +1,94 @@
+#include "PackParser.hpp"
+#include <cassert>
+
+using namespace std;
+
+// EFFECTS: Returns true for the characters isspace accepts in the C locale
+static bool is_space(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+         c == '\f';
+}
+
+// EFFECTS: Returns word quoted for an error message, or "the end of the
+//          input" if it is empty
+static string quoted(const char *word, size_t length) {
+  if (length == 0) {
+    return "the end of the input";
+  }
+  return "\"" + string(word, length) + "\"";
+}
+
+PackParser::PackParser(const char *text, size_t size) :
+  next(text), end(text + size), line(1) {}
+
+// Moves past whitespace, counting lines
+void PackParser::skip_space() {
+  while (next != end && is_space(*next)) {
+    line += (*next == '\n');
+    ++next;
+  }
+}
+
+// Sets word to the next run of characters up to whitespace, and returns
+// false if there is none
+bool PackParser::next_word(const char *&word, size_t &length) {
+  skip_space();
+  word = next;
+  while (next != end && !is_space(*next)) {
+    ++next;
+  }
+  length = next - word;
+  return length > 0;
+}
+
+// Records an error at the current line and returns false
+bool PackParser::fail(const string &message) {
+  error.line = line;
+  error.message = "line " + to_string(line) + ": " + message;
+  next = end;
+  return false;
+}
+
+bool PackParser::next_card(Card &card) {
+  if (failed()) {
+    return false;
+  }
+  const char *word = nullptr;
+  size_t length = 0;
+  if (!next_word(word, length)) {
+    return false;
+  }
+  Rank rank;
+  if (!Rank_parse(word, length, rank)) {
+    return fail("expected a rank, found " + quoted(word, length));
+  }
+  next_word(word, length);
+  if (length != 2 || word[0] != 'o' || word[1] != 'f') {
+    return fail("expected \"of\", found " + quoted(word, length));
+  }
+  next_word(word, length);
+  Suit suit;
+  if (!Suit_parse(word, length, suit)) {
+    return fail("expected a suit, found " + quoted(word, length));
+  }
+  card = Card(rank, suit);
+  return true;
+}
+
+bool PackParser::next_pack(array<Card, Pack::PACK_SIZE> &cards) {
+  for (int i = 0; i < Pack::PACK_SIZE; ++i) {
+    if (!next_card(cards[i])) {
+      if (i > 0 && !failed()) {
+        fail("pack ends after " + to_string(i) + " of " +
+             to_string(Pack::PACK_SIZE) + " cards");
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+bool PackParser::done() {
+  skip_space();
+  return next == end;
+}
@@ -0,0 +1,72 @@
+#ifndef PACKPARSER_HPP
+#define PACKPARSER_HPP
+/* PackParser.hpp
+ *
+ * Fast reading of packs written as text, one card per line
+ */
+
+#include "Card.hpp"
+#include "Pack.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+
+// Why parsing stopped
+struct ParseError {
+  int line = 0;             // from 1, or 0 if nothing went wrong
+  std::string message;      // starts with the line, for example "line 3: "
+};
+
+// Reads cards in the format of pack.in, "Nine of Spades", from text in
+// memory. The text may hold any number of packs one after another, for
+// example a corpus of recorded deals; words may be separated by any
+// whitespace, as with operator>>.
+//
+// Reading never allocates and never copies the text: names are found with
+// Rank_parse and Suit_parse. Malformed input stops the parser with an
+// error that gives its line, instead of failing an assertion.
+class PackParser {
+public:
+  // REQUIRES: text points to size characters that outlive the parser
+  // EFFECTS: Starts reading at the beginning of text
+  PackParser(const char *text, size_t size);
+
+  // MODIFIES: card
+  // EFFECTS: Reads the next card. Returns false, leaving card unchanged,
+  //          at the end of the text or if the text is malformed, which
+  //          failed() then tells apart.
+  bool next_card(Card &card);
+
+  // MODIFIES: cards
+  // EFFECTS: Reads the next Pack::PACK_SIZE cards, cards[0] first. Returns
+  //          false at the end of the text, or if the text is malformed or
+  //          ends part way through a pack, which is an error.
+  bool next_pack(std::array<Card, Pack::PACK_SIZE> &cards);
+
+  // EFFECTS: Returns true if only whitespace is left, or parsing failed
+  bool done();
+
+  // EFFECTS: Returns true if the text was malformed
+  bool failed() const { return error.line != 0; }
+
+  // EFFECTS: Returns why parsing failed
+  const ParseError & get_error() const { return error; }
+
+  // EFFECTS: Returns the line of the next character to read, from 1
+  int get_line() const { return line; }
+
+  // EFFECTS: Returns the next character to read, or the end of the text
+  const char * get_next() const { return next; }
+
+private:
+  const char *next;
+  const char *end;
+  int line;
+  ParseError error;
+
+  void skip_space();
+  bool next_word(const char *&word, size_t &length);
+  bool fail(const std::string &message);
+};
+
+#endif // PACKPARSER_HPP
@@ -0,0 +1,108 @@
+#include "PackParser.hpp"
+#include "unit_test_framework.hpp"
+
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// EFFECTS: Returns the text of pack in the format of pack.in
+static string pack_text(Pack pack) {
+    ostringstream os;
+    while (!pack.empty()) {
+        os << pack.deal_one() << '\n';
+    }
+    return os.str();
+}
+
+// The parser reads pack.in as Pack(istream&) does
+TEST(test_parser_pack_in) {
+    ifstream fin("pack.in");
+    string text((istreambuf_iterator<char>(fin)), istreambuf_iterator<char>());
+    ASSERT_FALSE(text.empty());
+    PackParser parser(text.data(), text.size());
+    array<Card, Pack::PACK_SIZE> cards;
+    ASSERT_TRUE(parser.next_pack(cards));
+    ASSERT_TRUE(parser.done());
+    ASSERT_FALSE(parser.failed());
+
+    istringstream is(text);
+    Pack expected(is);
+    Pack parsed(cards);
+    for (int i = 0; i < Pack::PACK_SIZE; ++i) {
+        ASSERT_EQUAL(parsed.deal_one(), expected.deal_one());
+    }
+}
+
+// Packs follow one another in any whitespace
+TEST(test_parser_many_packs) {
+    Pack first;
+    Pack second;
+    second.shuffle();
+    string text = pack_text(first) + "\n\n" + pack_text(second);
+    text[text.find('\n')] = '\t';
+
+    PackParser parser(text.data(), text.size());
+    array<Card, Pack::PACK_SIZE> cards;
+    for (Pack *expected : {&first, &second}) {
+        ASSERT_TRUE(parser.next_pack(cards));
+        for (const Card &card : cards) {
+            ASSERT_EQUAL(card, expected->deal_one());
+        }
+    }
+    ASSERT_FALSE(parser.next_pack(cards));
+    ASSERT_FALSE(parser.failed());
+    ASSERT_TRUE(parser.done());
+}
+
+TEST(test_parser_cards) {
+    string text = "  Ace of Hearts\r\nTwo   of\tClubs";
+    PackParser parser(text.data(), text.size());
+    Card card;
+    ASSERT_TRUE(parser.next_card(card));
+    ASSERT_EQUAL(card, Card(ACE, HEARTS));
+    ASSERT_EQUAL(parser.get_line(), 1);
+    ASSERT_TRUE(parser.next_card(card));
+    ASSERT_EQUAL(card, Card(TWO, CLUBS));
+    ASSERT_EQUAL(parser.get_line(), 2);
+    ASSERT_FALSE(parser.next_card(card));
+    ASSERT_EQUAL(card, Card(TWO, CLUBS));
+    ASSERT_FALSE(parser.failed());
+}
+
+// EFFECTS: Returns the error from reading text as packs
+static ParseError parse_error(const string &text) {
+    PackParser parser(text.data(), text.size());
+    array<Card, Pack::PACK_SIZE> cards;
+    while (parser.next_pack(cards)) {}
+    return parser.get_error();
+}
+
+TEST(test_parser_errors) {
+    ParseError error = parse_error("Nine of Spades\nTen of Spades\nNien of Spades\n");
+    ASSERT_EQUAL(error.line, 3);
+    ASSERT_EQUAL(error.message, "line 3: expected a rank, found \"Nien\"");
+
+    error = parse_error("Nine of Spades\n\nTen off Spades\n");
+    ASSERT_EQUAL(error.line, 3);
+    ASSERT_EQUAL(error.message, "line 3: expected \"of\", found \"off\"");
+
+    error = parse_error("Nine of Spade\n");
+    ASSERT_EQUAL(error.message, "line 1: expected a suit, found \"Spade\"");
+
+    error = parse_error("Nine of");
+    ASSERT_EQUAL(error.message,
+                 "line 1: expected a suit, found the end of the input");
+
+    string text = pack_text(Pack()) + "Nine of Spades\nTen of Spades\n";
+    error = parse_error(text);
+    ASSERT_EQUAL(error.line, 27);
+    ASSERT_EQUAL(error.message, "line 27: pack ends after 2 of 24 cards");
+
+    ASSERT_EQUAL(parse_error(pack_text(Pack())).line, 0);
+}
+
+TEST_MAIN()
@@ -1,10 +1,21 @@
 #include "Pack.hpp"
 #include "unit_test_framework.hpp"
 
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 
+// EFFECTS: Returns all 24 cards of pack in dealing order
+static vector<Card> deal_all(Pack &pack) {
+    vector<Card> cards;
+    while (!pack.empty()) {
+        cards.push_back(pack.deal_one());
+    }
+    return cards;
+}
+
 TEST(test_pack_default_ctor) {
     Pack pack;
     Card first = pack.deal_one();
@@ -14,4 +25,81 @@ TEST(test_pack_default_ctor) {
 
 // Add more tests here
 
+// The single-pass shuffle matches seven in shuffles done one at a time
+TEST(test_pack_shuffle_matches_seven_in_shuffles) {
+    Pack fast;
+    fast.shuffle();
+
+    Pack slow;
+    for (int i = 0; i < 7; ++i) {
+        slow.shuffle(IN_SHUFFLE, 1);
+    }
+    ASSERT_TRUE(deal_all(fast) == deal_all(slow));
+}
+
+TEST(test_pack_in_shuffle_once) {
+    Pack pack;
+    pack.shuffle(IN_SHUFFLE, 1);
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, CLUBS));
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, SPADES));
+    ASSERT_EQUAL(pack.deal_one(), Card(TEN, CLUBS));
+}
+
+TEST(test_pack_out_shuffle_once) {
+    Pack pack;
+    pack.shuffle(OUT_SHUFFLE, 1);
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, SPADES));
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, CLUBS));
+    ASSERT_EQUAL(pack.deal_one(), Card(TEN, SPADES));
+}
+
+// 20 in shuffles or 11 out shuffles restore a 24 card pack
+TEST(test_pack_shuffle_cycles) {
+    Pack pack;
+    vector<Card> original = deal_all(pack);
+
+    pack.shuffle(IN_SHUFFLE, 20);
+    ASSERT_TRUE(deal_all(pack) == original);
+    pack.shuffle(OUT_SHUFFLE, 11);
+    ASSERT_TRUE(deal_all(pack) == original);
+    pack.shuffle(OUT_SHUFFLE, 0);
+    ASSERT_TRUE(deal_all(pack) == original);
+
+    pack.shuffle(IN_SHUFFLE, 10);
+    ASSERT_FALSE(deal_all(pack) == original);
+}
+
+TEST(test_pack_shuffle_resets_next) {
+    Pack pack;
+    pack.deal_one();
+    pack.shuffle(OUT_SHUFFLE, 1);
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, SPADES));
+}
+
+// A seeded random shuffle gives the same order on every platform
+TEST(test_pack_random_shuffle_reproducible) {
+    Pack pack;
+    Rng rng(1);
+    pack.shuffle(rng);
+    ASSERT_EQUAL(pack.deal_one(), Card(KING, CLUBS));
+    ASSERT_EQUAL(pack.deal_one(), Card(JACK, SPADES));
+    ASSERT_EQUAL(pack.deal_one(), Card(KING, HEARTS));
+}
+
+// A random shuffle rearranges the cards without losing or repeating any
+TEST(test_pack_random_shuffle_is_permutation) {
+    Pack sorted;
+    vector<Card> original = deal_all(sorted);
+    sort(original.begin(), original.end());
+
+    Pack pack;
+    Rng rng(2024, 3);
+    for (int n = 0; n < 100; ++n) {
+        pack.shuffle(rng);
+        vector<Card> shuffled = deal_all(pack);
+        sort(shuffled.begin(), shuffled.end());
+        ASSERT_TRUE(shuffled == original);
+    }
+}
+
 TEST_MAIN()
@@ -0,0 +1,198 @@
+#include "PerfCounters.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+const char * CounterEvent_name(CounterEvent event) {
+  static const char *names[NUM_EVENTS] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses"
+  };
+  return names[event];
+}
+
+const char * GamePhase_name(GamePhase phase) {
+  static const char *names[NUM_PHASES] = {
+    "deal", "bidding", "play", "scoring", "decision"
+  };
+  return names[phase];
+}
+
+void PhaseTotals::merge(const PhaseTotals &other) {
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    counted[e] = counted[e] || other.counted[e];
+  }
+  for (int p = 0; p < NUM_PHASES; ++p) {
+    regions[p] += other.regions[p];
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      counts[p][e] += other.counts[p][e];
+    }
+  }
+}
+
+ostream & operator<<(ostream &os, const PhaseTotals &totals) {
+  os << "phase\tregions";
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    os << '\t' << CounterEvent_name(static_cast<CounterEvent>(e));
+  }
+  os << '\n';
+  for (int p = 0; p < NUM_PHASES; ++p) {
+    os << GamePhase_name(static_cast<GamePhase>(p)) << '\t'
+       << totals.regions[p];
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      os << '\t';
+      if (totals.counted[e]) {
+        os << totals.counts[p][e];
+      } else {
+        os << "n/a";
+      }
+    }
+    os << '\n';
+  }
+  return os;
+}
+
+#ifdef __linux__
+
+// EFFECTS: Opens a user-space counter for the calling thread in the group
+//          led by group_fd, or as a new group leader if group_fd is -1.
+//          Returns the file descriptor, or -1 if the event is unavailable.
+static int open_event(uint32_t type, uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.disabled = (group_fd == -1);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                  group_fd, 0));
+}
+
+PerfCounters::PerfCounters() : group_fd(-1), num_open(0), num_reads(0) {
+  const uint32_t types[NUM_EVENTS] = {
+    PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+    PERF_TYPE_HW_CACHE
+  };
+  const uint64_t configs[NUM_EVENTS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_BRANCH_MISSES,
+    PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 |
+      PERF_COUNT_HW_CACHE_RESULT_MISS << 16
+  };
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    fds[e] = open_event(types[e], configs[e], group_fd);
+    slots[e] = -1;
+    if (fds[e] != -1) {
+      group_fd = (group_fd == -1) ? fds[e] : group_fd;
+      slots[e] = num_open++;
+      totals.counted[e] = true;
+    }
+  }
+  if (group_fd != -1) {
+    ioctl(group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  measure_read_cost();
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+void PerfCounters::read(uint64_t values[NUM_EVENTS]) const {
+  ++num_reads;
+  // A group read returns the number of events, then each count
+  uint64_t buffer[1 + NUM_EVENTS] = {};
+  if (group_fd != -1) {
+    ssize_t size = ::read(group_fd, buffer, sizeof(buffer));
+    if (size < static_cast<ssize_t>((1 + num_open) * sizeof(uint64_t))) {
+      memset(buffer, 0, sizeof(buffer));
+    }
+  }
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    values[e] = slots[e] == -1 ? 0 : buffer[1 + slots[e]];
+  }
+}
+
+#else
+
+PerfCounters::PerfCounters() : group_fd(-1), num_open(0), num_reads(0) {
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    fds[e] = -1;
+    slots[e] = -1;
+  }
+  measure_read_cost();
+}
+
+PerfCounters::~PerfCounters() {}
+
+void PerfCounters::read(uint64_t values[NUM_EVENTS]) const {
+  ++num_reads;
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    values[e] = 0;
+  }
+}
+
+#endif // __linux__
+
+bool PerfCounters::available() const {
+  return num_open > 0;
+}
+
+// Two reads in a row count the end of the first and the start of the
+// second, which is one read. The least of several tries is the cost of a
+// read alone, without interrupts or cache misses of other work.
+void PerfCounters::measure_read_cost() {
+  const int TRIES = 16;
+  uint64_t before[NUM_EVENTS];
+  uint64_t after[NUM_EVENTS];
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    read_cost[e] = UINT64_MAX;
+  }
+  for (int i = 0; i < TRIES; ++i) {
+    read(before);
+    read(after);
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      read_cost[e] = min(read_cost[e], after[e] - before[e]);
+    }
+  }
+}
+
+void PerfCounters::add(GamePhase phase, const uint64_t start[NUM_EVENTS],
+                       uint64_t start_reads) {
+  uint64_t nested_reads = num_reads - start_reads;
+  uint64_t now[NUM_EVENTS];
+  read(now);
+  ++totals.regions[phase];
+  for (int e = 0; e < NUM_EVENTS; ++e) {
+    uint64_t counted = now[e] - start[e];
+    uint64_t overhead = (1 + nested_reads) * read_cost[e];
+    totals.counts[phase][e] += counted > overhead ? counted - overhead : 0;
+  }
+}
+
+PhaseTotals PerfCounters::take_totals() {
+  PhaseTotals taken = totals;
+  for (int p = 0; p < NUM_PHASES; ++p) {
+    totals.regions[p] = 0;
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+      totals.counts[p][e] = 0;
+    }
+  }
+  return taken;
+}
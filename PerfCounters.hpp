@@ -0,0 +1,138 @@
+#ifndef PERFCOUNTERS_HPP
+#define PERFCOUNTERS_HPP
+/* PerfCounters.hpp
+ *
+ * Hardware performance counters for each phase of a game
+ */
+
+#include <cstdint>
+#include <iostream>
+
+// Hardware events that are counted
+enum CounterEvent {
+  EVENT_CYCLES,
+  EVENT_INSTRUCTIONS,
+  EVENT_BRANCH_MISSES,
+  EVENT_L1D_MISSES,     // level 1 data cache read misses
+  NUM_EVENTS
+};
+
+// Parts of a game that are counted separately. Decisions are the calls
+// into players; they are counted again within bidding and play.
+enum GamePhase {
+  PHASE_DEAL,           // shuffling and dealing
+  PHASE_BIDDING,
+  PHASE_PLAY,           // the five tricks, including who wins each
+  PHASE_SCORING,
+  PHASE_DECISION,
+  NUM_PHASES
+};
+
+//EFFECTS Returns the name of event, for example "cycles"
+const char * CounterEvent_name(CounterEvent event);
+
+//EFFECTS Returns the name of phase, for example "deal"
+const char * GamePhase_name(GamePhase phase);
+
+// Event counts summed over every counted region of each phase
+struct PhaseTotals {
+  bool counted[NUM_EVENTS] = {}; // false where the event is not available
+  uint64_t regions[NUM_PHASES] = {};
+  uint64_t counts[NUM_PHASES][NUM_EVENTS] = {};
+
+  //EFFECTS adds other's counts to these counts
+  void merge(const PhaseTotals &other);
+};
+
+//EFFECTS Writes one line per phase as tab-separated values: the phase,
+//  the regions counted, then the total of each event, or "n/a" for events
+//  that could not be counted
+std::ostream & operator<<(std::ostream &os, const PhaseTotals &totals);
+
+// Counts hardware events on the calling thread with Linux perf_event_open.
+// Only user-space events are counted. Events the kernel or CPU cannot
+// count, for example under perf_event_paranoid or in a virtual machine,
+// are left out; elsewhere than Linux nothing is counted. Reading the
+// counters is a system call, so a counted region costs about a
+// microsecond.
+//
+// Regions may nest: decisions are counted inside bidding and play. The
+// reads that start and end a region fall partly inside it, and the reads
+// of every region nested in it fall wholly inside it. The user-space
+// events of one read are measured when the counters are opened, and one
+// read, plus one for each read nested in the region, is taken out of each
+// region's counts. The little bookkeeping around each read is not taken
+// out.
+class PerfCounters {
+public:
+  // EFFECTS: Opens and starts the counters for the calling thread
+  PerfCounters();
+
+  // EFFECTS: Closes the counters
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters & operator=(const PerfCounters &) = delete;
+
+  // EFFECTS: Returns true if at least one event is counted
+  bool available() const;
+
+  // MODIFIES: values
+  // EFFECTS: Sets values to the current count of each event, or 0 for
+  //          events that are not counted
+  void read(uint64_t values[NUM_EVENTS]) const;
+
+  // EFFECTS: Returns the number of reads made so far
+  uint64_t reads() const { return num_reads; }
+
+  // REQUIRES: start was read when reads() was start_reads
+  // EFFECTS: Adds the events since start to phase, less the events of
+  //          the reads at either end and of the reads made in between
+  void add(GamePhase phase, const uint64_t start[NUM_EVENTS],
+           uint64_t start_reads);
+
+  // EFFECTS: Returns the totals so far and starts new ones
+  PhaseTotals take_totals();
+
+private:
+  int group_fd;                  // -1 if nothing is counted
+  int fds[NUM_EVENTS];
+  int slots[NUM_EVENTS];         // position of each event in a group read
+  int num_open;
+  mutable uint64_t num_reads;
+  uint64_t read_cost[NUM_EVENTS]; // events counted by one read
+  PhaseTotals totals;
+
+  void measure_read_cost();
+};
+
+// Adds the events between its construction and its destruction to a phase.
+// Does nothing if counters is null, so it can stay in code that is only
+// sometimes measured.
+class PhaseScope {
+public:
+  PhaseScope(PerfCounters *counters, GamePhase phase) :
+    counters(counters), phase(phase) {
+    if (counters) {
+      counters->read(start);
+      start_reads = counters->reads();
+    }
+  }
+
+  ~PhaseScope() {
+    if (counters) {
+      counters->add(phase, start, start_reads);
+    }
+  }
+
+  PhaseScope(const PhaseScope &) = delete;
+  PhaseScope & operator=(const PhaseScope &) = delete;
+
+private:
+  PerfCounters *counters;
+  GamePhase phase;
+  uint64_t start[NUM_EVENTS];
+  uint64_t start_reads = 0;
+};
+
+#endif // PERFCOUNTERS_HPP
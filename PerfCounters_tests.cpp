@@ -0,0 +1,98 @@
+#include "PerfCounters.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// EFFECTS: Returns a sum the compiler cannot work out ahead of time
+static uint64_t busy_work(int n) {
+    volatile uint64_t total = 0;
+    for (int i = 0; i < n; ++i) {
+        total = total + i * i;
+    }
+    return total;
+}
+
+TEST(test_phase_names) {
+    ASSERT_EQUAL(string(GamePhase_name(PHASE_DEAL)), "deal");
+    ASSERT_EQUAL(string(GamePhase_name(PHASE_SCORING)), "scoring");
+    ASSERT_EQUAL(string(CounterEvent_name(EVENT_INSTRUCTIONS)), "instructions");
+}
+
+// Regions add up in their phase, whether or not the machine lets us count
+TEST(test_phase_scope_counts_regions) {
+    PerfCounters counters;
+    for (int i = 0; i < 3; ++i) {
+        PhaseScope scope(&counters, PHASE_PLAY);
+        busy_work(1000);
+    }
+    {
+        PhaseScope scope(&counters, PHASE_DEAL);
+    }
+    PhaseTotals totals = counters.take_totals();
+    ASSERT_EQUAL(totals.regions[PHASE_PLAY], 3u);
+    ASSERT_EQUAL(totals.regions[PHASE_DEAL], 1u);
+    ASSERT_EQUAL(totals.regions[PHASE_BIDDING], 0u);
+    if (totals.counted[EVENT_INSTRUCTIONS]) {
+        ASSERT_TRUE(totals.counts[PHASE_PLAY][EVENT_INSTRUCTIONS] >
+                    totals.counts[PHASE_DEAL][EVENT_INSTRUCTIONS]);
+    }
+    for (int e = 0; e < NUM_EVENTS; ++e) {
+        ASSERT_TRUE(counters.available() || !totals.counted[e]);
+    }
+
+    // Taking the totals starts new ones
+    PhaseTotals next = counters.take_totals();
+    ASSERT_EQUAL(next.regions[PHASE_PLAY], 0u);
+}
+
+// The reads of nested regions are taken out of the region around them
+TEST(test_phase_scope_nested_reads_taken_out) {
+    const int NESTED = 100;
+    PerfCounters counters;
+    for (int nested = 0; nested <= NESTED; nested += NESTED) {
+        PhaseScope scope(&counters, nested ? PHASE_PLAY : PHASE_DEAL);
+        busy_work(1000);
+        for (int i = 0; i < nested; ++i) {
+            PhaseScope decision(&counters, PHASE_DECISION);
+        }
+    }
+    PhaseTotals totals = counters.take_totals();
+    ASSERT_EQUAL(totals.regions[PHASE_DECISION], uint64_t(NESTED));
+    if (totals.counted[EVENT_INSTRUCTIONS]) {
+        uint64_t plain = totals.counts[PHASE_DEAL][EVENT_INSTRUCTIONS];
+        uint64_t nested = totals.counts[PHASE_PLAY][EVENT_INSTRUCTIONS];
+        // Only the bookkeeping of each nested region is left
+        ASSERT_TRUE(nested < plain + NESTED * 200);
+    }
+}
+
+// A null scope does nothing
+TEST(test_phase_scope_null) {
+    PhaseScope scope(nullptr, PHASE_PLAY);
+    ASSERT_EQUAL(busy_work(10), 285u);
+}
+
+TEST(test_phase_totals_merge_and_print) {
+    PhaseTotals a;
+    a.counted[EVENT_CYCLES] = true;
+    a.regions[PHASE_DEAL] = 2;
+    a.counts[PHASE_DEAL][EVENT_CYCLES] = 100;
+    PhaseTotals b;
+    b.regions[PHASE_DEAL] = 1;
+    b.counts[PHASE_DEAL][EVENT_CYCLES] = 50;
+    a.merge(b);
+    ASSERT_EQUAL(a.regions[PHASE_DEAL], 3u);
+    ASSERT_EQUAL(a.counts[PHASE_DEAL][EVENT_CYCLES], 150u);
+
+    ostringstream os;
+    os << a;
+    string text = os.str();
+    ASSERT_EQUAL(text.substr(0, text.find('\n')),
+                 "phase\tregions\tcycles\tinstructions\tbranch_misses\tl1d_misses");
+    ASSERT_TRUE(text.find("deal\t3\t150\tn/a\tn/a\tn/a\n") != string::npos);
+}
+
+TEST_MAIN()
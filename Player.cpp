@@ -1,179 +1,283 @@
 #include <cassert>
 #include "Player.hpp"
+#include "SimplePlayer.hpp"
+#include "CardSet.hpp"
+#include "Random.hpp"
+#include "Solver.hpp"
+#include "BidTable.hpp"
+#include "Pack.hpp"
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
 
 using namespace std;
 
-class SimplePlayer : public Player {
-  private:
-    string name;
-    vector<Card> hand;
-
-  public:
-    SimplePlayer(const std::string &name) : name(name) {}
+// Settings of the "MonteCarlo" strategy
+struct MonteCarloOptions {
+  int samples = 100;        // deals sampled per card played
+  int time_budget_ms = 0;   // time allowed per card played, 0 for no limit
+};
 
-    const std::string & get_name() const override {
-        return name;
+// Plays by perfect-information Monte Carlo: deals the unseen cards at
+// random, consistently with everything seen in the hand so far, solves
+// each deal double dummy, and plays the card that takes the most tricks
+// on average. Bids and discards as SimplePlayer does.
+//
+// Without see_trump and see_play, as when driven outside of Game, it plays
+// as SimplePlayer does too.
+class MonteCarloPlayer : public SimplePlayer {
+  private:
+    MonteCarloOptions options;
+    Rng rng;
+    Solver solver;
+
+    // What has been seen of the current hand, seats counted from this player
+    bool informed = false;
+    Suit trump = SPADES;
+    Card upcard;
+    int dealer = 0;
+    CardSet discard;          // set if this player dealt and took the upcard
+    CardSet seen;             // every card played
+    int cards_played[4] = {0, 0, 0, 0};
+    unsigned voids[4] = {0, 0, 0, 0}; // bit s set once a seat shows out of s
+    int leader = 0;
+    int played = 0;
+    Card trick[TRICK_SIZE];
+
+    // The cards this player cannot see, refilled and shuffled for each
+    // sample, so sampling allocates nothing
+    array<Card, Pack::PACK_SIZE> unseen_cards;
+    int num_unseen = 0;
+
+    // EFFECTS: Returns a name-derived seed, so a game's result does not
+    //          depend on how many games came before it
+    static uint64_t seed_for(const string &name) {
+      uint64_t hash = 0xCBF29CE484222325;
+      for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001B3;
+      }
+      return hash;
     }
 
-    void add_card(const Card &c) override {
-      assert(hand.size() < MAX_HAND_SIZE);
-      hand.push_back(c);
+    // EFFECTS: Deals the unseen cards to the seats that still need them
+    //          and may hold them, leaving the rest undealt. Returns false
+    //          if the voids seen leave no place for a card.
+    bool deal_unseen(int need[4], bool use_voids, SolverPosition &pos) {
+      int undealt = num_unseen;
+      for (int seat = 1; seat < 4; ++seat) {
+        undealt -= need[seat];
+      }
+      assert(undealt >= 0);
+      for (int i = 0; i < num_unseen; ++i) {
+        const Card &card = unseen_cards[i];
+        unsigned suit_bit = 1u << card.get_suit(trump);
+        int weights[4] = {undealt, 0, 0, 0};
+        int total = undealt;
+        for (int seat = 1; seat < 4; ++seat) {
+          if (!use_voids || !(voids[seat] & suit_bit)) {
+            weights[seat] = need[seat];
+            total += need[seat];
+          }
+        }
+        if (total == 0) {
+          return false;
+        }
+        int pick = static_cast<int>(rng.below(total));
+        int seat = 0;
+        while (pick >= weights[seat]) {
+          pick -= weights[seat++];
+        }
+        if (seat == 0) {
+          --undealt;
+        } else {
+          pos.hands[seat].add(card);
+          --need[seat];
+        }
+      }
+      return true;
     }
 
-    void remove_card(const Card &c) {
-      assert(hand.size() > 0);
+    // EFFECTS: Returns the current position with the cards this player
+    //          cannot see dealt at random
+    SolverPosition sample_position() {
+      SolverPosition pos;
+      pos.trump = trump;
+      pos.leader = leader;
+      pos.played = played;
+      copy(trick, trick + played, pos.trick);
+      pos.hands[0] = hand.cards();
+
+      int need[4] = {0, 0, 0, 0};
+      for (int seat = 1; seat < 4; ++seat) {
+        need[seat] = MAX_HAND_SIZE - cards_played[seat];
+      }
+      CardSet unseen = CardSet(CardSet::EUCHRE_BITS) & ~seen &
+                       ~hand.cards() & ~discard & ~CardSet(CardSet::bit(upcard));
+      // The dealer keeps the upcard when it is ordered up
+      bool upcard_held = upcard.get_suit() == trump && dealer != 0 &&
+                         !seen.contains(upcard);
+      if (upcard_held) {
+        pos.hands[dealer].add(upcard);
+        --need[dealer];
+      }
 
-      int index_to_remove = -1;
-      for (int i = 0; i < hand.size(); i++) {
-        if (hand[i] == c) {
-          index_to_remove = i;
-          break;
+      num_unseen = 0;
+      for (; !unseen.empty(); unseen.remove(unseen.lowest())) {
+        unseen_cards[num_unseen++] = unseen.lowest();
+      }
+      for (int attempt = 0; ; ++attempt) {
+        for (int i = num_unseen; i > 1; --i) {
+          swap(unseen_cards[i - 1], unseen_cards[rng.below(i)]);
+        }
+        SolverPosition dealt = pos;
+        int still_needed[4] = {0, need[1], need[2], need[3]};
+        // Give up on the voids if they cannot be kept after many tries
+        if (deal_unseen(still_needed, attempt < 20, dealt)) {
+          return dealt;
         }
       }
-
-      assert(index_to_remove != -1);
-      hand.erase(hand.begin() + index_to_remove);
     }
 
-    bool make_trump(const Card &upcard, bool is_dealer,
-               int round, Suit &order_up_suit) const override {
-      assert(round == 1 || round == 2);
+    // EFFECTS: Returns the legal card that takes the most tricks on
+    //          average over the sampled deals
+    Card choose_card() {
+      CardSet legal = hand.cards();
+      if (played > 0) {
+        CardSet follow = legal & CardSet_suit(trick[0].get_suit(trump), trump);
+        legal = follow.empty() ? legal : follow;
+      }
+      if (legal.size() == 1) {
+        return legal.lowest();
+      }
 
-      if (round == 1) {
-        int valuable_card_counter = 0;
-        Suit trump_pot = upcard.get_suit();
-        for (const Card &card : hand) {
-          if (card.get_suit(trump_pot) == trump_pot &&
-              card.is_face_or_ace()) {
-                ++valuable_card_counter;
-          }
+      using Clock = chrono::steady_clock;
+      Clock::time_point deadline =
+        Clock::now() + chrono::milliseconds(options.time_budget_ms);
+      int totals[NUM_CARD_INDICES] = {};
+      for (int n = 0; n < options.samples; ++n) {
+        Card moves[MAX_HAND_SIZE];
+        int tricks[MAX_HAND_SIZE];
+        int num_moves = solver.solve_moves(sample_position(), moves, tricks);
+        for (int i = 0; i < num_moves; ++i) {
+          totals[Card_index(moves[i])] += tricks[i];
         }
-
-        if (valuable_card_counter >= 2) {
-          order_up_suit = upcard.get_suit();
-          return true;
-        } else return false;
-      } 
-      else {
-        int valuable_card_counter = 0;
-        for (const Card &card : hand) {
-          if (card.get_suit() == Suit_next(upcard.get_suit()) &&
-              card.is_face_or_ace()) {
-                ++valuable_card_counter;
-          }
+        if (options.time_budget_ms > 0 && Clock::now() >= deadline) {
+          break;
         }
-
-        if (valuable_card_counter >= 1 || is_dealer) {
-          order_up_suit = Suit_next(upcard.get_suit());
-          return true;
-        } else return false;
       }
-    }
 
-    void add_and_discard(const Card &upcard) override {
-      assert(hand.size() >= 1 && hand.size() <= MAX_HAND_SIZE);
-      
-      hand.push_back(upcard);
-
-      Card lowest_card = hand[0];
-      int lowest_card_index = 0;
-      for (int i = 0; i < hand.size(); ++i) {
-        if (Card_less(hand[i], hand[lowest_card_index], upcard.get_suit())) {
-          lowest_card = hand[i];
-          lowest_card_index = i;
+      // Ties go to the lowest card
+      Card best = legal.lowest();
+      for (CardSet rest = legal; !rest.empty(); rest.remove(rest.lowest())) {
+        Card card = rest.lowest();
+        if (totals[Card_index(best)] < totals[Card_index(card)]) {
+          best = card;
         }
       }
+      return best;
+    }
 
-      hand.erase(hand.begin() + lowest_card_index);
+  public:
+    MonteCarloPlayer(const string &name, const MonteCarloOptions &options) :
+      SimplePlayer(name), options(options), rng(seed_for(name)) {}
+
+    void reset() override {
+      SimplePlayer::reset();
+      rng = Rng(seed_for(get_name()));
+      informed = false;
+      discard = CardSet();
+      seen = CardSet();
+      fill(cards_played, cards_played + 4, 0);
+      fill(voids, voids + 4, 0u);
+      leader = 0;
+      played = 0;
+    }
 
+    void add_and_discard(const Card &upcard) override {
+      CardSet before = hand.cards() | CardSet(CardSet::bit(upcard));
+      SimplePlayer::add_and_discard(upcard);
+      discard = before & ~hand.cards();
     }
 
-    Card lead_card(Suit trump) override {
-      assert(!hand.empty());
-      
-      vector<Card> trump_cards;
-      vector<Card> non_trump_cards;
-
-      for (Card card : hand) {
-        if (card.is_trump(trump)) { 
-          trump_cards.push_back(card); 
-        } 
-        else { 
-          non_trump_cards.push_back(card);
-        }
+    void see_trump(const Card &upcard_in, int dealer_in, int maker,
+                   Suit trump_in) override {
+      informed = true;
+      trump = trump_in;
+      upcard = upcard_in;
+      dealer = dealer_in;
+      if (dealer != 0 || upcard.get_suit() != trump) {
+        discard = CardSet();
       }
+      seen = CardSet();
+      fill(cards_played, cards_played + 4, 0);
+      fill(voids, voids + 4, 0u);
+      played = 0;
+    }
 
-      Card high_card;
-      if (!non_trump_cards.empty()) {
-        high_card = non_trump_cards[0];
-        for (const Card &card : non_trump_cards) {
-          if (Card_less(high_card, card, trump)) {
-            high_card = card;
-          }
+    void see_play(const Card &card, int seat) override {
+      if (played == 0) {
+        leader = seat;
+      } else {
+        Suit led = trick[0].get_suit(trump);
+        if (card.get_suit(trump) != led) {
+          voids[seat] |= 1u << led;
         }
       }
-      else {
-        high_card = trump_cards[0];
-        for (const Card &card : trump_cards) {
-          if (Card_less(high_card, card, trump)) {
-            high_card = card;
-          }
-        }
-      }
-
-      remove_card(high_card);
-      return high_card;
+      trick[played] = card;
+      played = (played + 1) % TRICK_SIZE;
+      seen.add(card);
+      ++cards_played[seat];
     }
 
-    Card play_card(const Card &led_card, Suit trump) override {
-      vector<Card> follow_suit;
-      vector<Card> no_follow_suit;
-
-      for (const Card &card : hand) {
-        if (card.get_suit(trump) == led_card.get_suit(trump)) {
-          follow_suit.push_back(card);
-        } 
-        else {
-          no_follow_suit.push_back(card);
-        }
+    Card lead_card(Suit trump_in) override {
+      if (!informed || played != 0 || trump_in != trump) {
+        return SimplePlayer::lead_card(trump_in);
       }
+      leader = 0;
+      Card card = choose_card();
+      hand.remove(card);
+      return card;
+    }
 
-      Card card_to_play;
-      if (!follow_suit.empty()) {
-        card_to_play = follow_suit[0];
-        for (const Card &card : follow_suit) {
-          if (Card_less(card_to_play, card, trump)) {
-            card_to_play = card;
-          }
-        }
-      }
-      else {
-        card_to_play = no_follow_suit[0];
-        for (const Card &card : no_follow_suit) {
-          if (Card_less(card, card_to_play, trump)) {
-            card_to_play = card;
-          }
-        }
+    Card play_card(const Card &led_card, Suit trump_in) override {
+      if (!informed || played == 0 || !(trick[0] == led_card) ||
+          trump_in != trump) {
+        return SimplePlayer::play_card(led_card, trump_in);
       }
-
-      remove_card(card_to_play);
-      return card_to_play;
+      Card card = choose_card();
+      hand.remove(card);
+      return card;
     }
 };
 
 class HumanPlayer : public Player {
   private: 
     string name;
-    vector<Card> hand;
+    // Room for a full hand and the upcard, kept in order
+    Card hand[MAX_HAND_SIZE + 1];
+    int hand_size = 0;
 
     void print_hand() const {
-      for (size_t i=0; i < hand.size(); ++i)
+      for (int i=0; i < hand_size; ++i)
         cout << "Human player " << name << "'s hand: "
             << "[" << i << "] " << hand[i] << "\n";
     }
+
+    // EFFECTS: Removes and returns the card at index i
+    Card take(int i) {
+      assert(0 <= i && i < hand_size);
+      Card card = hand[i];
+      copy(hand + i + 1, hand + hand_size, hand + i);
+      --hand_size;
+      return card;
+    }
   
   public: 
     HumanPlayer(const string &name) : name(name) {}
@@ -182,10 +286,14 @@ class HumanPlayer : public Player {
       return name;
     }
 
+    void reset() override {
+      hand_size = 0;
+    }
+
     void add_card(const Card &c) override {
-      assert(hand.size() < MAX_HAND_SIZE);
-      hand.push_back(c);
-      sort(hand.begin(), hand.end());
+      assert(hand_size < MAX_HAND_SIZE);
+      hand[hand_size++] = c;
+      sort(hand, hand + hand_size);
     }
 
     bool make_trump(const Card &upcard, bool is_dealer,
@@ -209,7 +317,8 @@ class HumanPlayer : public Player {
 
     void add_and_discard(const Card &upcard) override {
       print_hand();
-      hand.push_back(upcard);
+      assert(hand_size <= MAX_HAND_SIZE);
+      hand[hand_size++] = upcard;
   
       cout << "Discard upcard: [-1]\n";
       cout << "Human player " << name << ", please select a card to discard:\n";
@@ -218,9 +327,9 @@ class HumanPlayer : public Player {
       cin >> answer;
    
       if (answer == -1) { //discard upcard
-        for (int i = 0; i < hand.size(); ++i) {
+        for (int i = 0; i < hand_size; ++i) {
           if (hand[i] == upcard) {
-            hand.erase(hand.begin() + i);
+            take(i);
 
             break;
           }
@@ -228,9 +337,9 @@ class HumanPlayer : public Player {
       }
       else {
 
-        hand.erase(hand.begin() + answer);
+        take(answer);
       }
-      sort(hand.begin(), hand.end());
+      sort(hand, hand + hand_size);
 
     }
 
@@ -241,9 +350,7 @@ class HumanPlayer : public Player {
       int answer;
       cin >> answer;
 
-      Card selected_card = hand[answer];
-      hand.erase(hand.begin() + answer);
-      return selected_card;
+      return take(answer);
     }
 
     Card play_card(const Card &led_card, Suit trump) override {
@@ -253,19 +360,114 @@ class HumanPlayer : public Player {
       int answer;
       cin >> answer;
 
-      Card selected_card = hand[answer];
-      hand.erase(hand.begin() + answer);
-      return selected_card;
+      return take(answer);
     }
 };
 
+// Bids from a BidTable, for example one of expected values from
+// simulation, and otherwise plays as SimplePlayer does. Hands the table
+// does not cover, such as hand-built hands with repeated cards, are bid as
+// SimplePlayer bids them.
+class TablePlayer : public SimplePlayer {
+  private:
+    const BidTable &table;
+
+  public:
+    TablePlayer(const string &name, const BidTable &table) :
+      SimplePlayer(name), table(table) {}
+
+    bool make_trump(const Card &upcard, bool is_dealer,
+                    int round, Suit &order_up_suit) const override {
+      BidSituation situation;
+      situation.hand = hand.cards();
+      situation.upcard = upcard;
+      situation.is_dealer = is_dealer;
+      situation.round = round;
+      if (hand.size() != situation.hand.size() ||
+          !BidTable::covers(situation)) {
+        return SimplePlayer::make_trump(upcard, is_dealer, round,
+                                        order_up_suit);
+      }
+      return table.make_trump(situation, order_up_suit);
+    }
+};
+
+// EFFECTS: Returns the table of the "Table[:FILE]" strategy, loading FILE
+//          the first time it is named, or null if strategy is not in that
+//          form or FILE does not hold a table. Tables are kept for the
+//          life of the program and shared between threads.
+static const BidTable * find_bid_table(const string &strategy) {
+  const string prefix = "Table";
+  if (strategy == prefix) {
+    return &BidTable_simple();
+  }
+  if (strategy.compare(0, prefix.size() + 1, prefix + ":") != 0) {
+    return nullptr;
+  }
+  string filename = strategy.substr(prefix.size() + 1);
+
+  static mutex tables_mutex;
+  static map<string, unique_ptr<BidTable>> tables;
+  lock_guard<mutex> lock(tables_mutex);
+  auto found = tables.find(filename);
+  if (found == tables.end()) {
+    unique_ptr<BidTable> table(new BidTable);
+    ifstream fin(filename, ios::binary);
+    if (!table->read(fin)) {
+      table.reset();
+    }
+    found = tables.emplace(filename, move(table)).first;
+  }
+  return found->second.get();
+}
+
+// MODIFIES: options
+// EFFECTS: Reads "MonteCarlo[:SAMPLES[:MILLISECONDS]]" into options.
+//          Returns false if strategy is not in that form.
+static bool parse_monte_carlo(const string &strategy,
+                              MonteCarloOptions &options) {
+  const string prefix = "MonteCarlo";
+  if (strategy.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  int *fields[] = {&options.samples, &options.time_budget_ms};
+  size_t pos = prefix.size();
+  for (int *field : fields) {
+    if (pos == strategy.size()) {
+      break;
+    }
+    size_t end = strategy.find(':', pos + 1);
+    string digits = strategy.substr(pos + 1, end - pos - 1);
+    if (strategy[pos] != ':' || digits.empty() || digits.size() > 9 ||
+        digits.find_first_not_of("0123456789") != string::npos) {
+      return false;
+    }
+    *field = stoi(digits);
+    pos = end == string::npos ? strategy.size() : end;
+  }
+  return pos == strategy.size() && options.samples > 0;
+}
+
+bool Player_strategy_valid(const string &strategy) {
+  MonteCarloOptions options;
+  return strategy == "Simple" || strategy == "Human" ||
+         parse_monte_carlo(strategy, options) || find_bid_table(strategy);
+}
+
 Player * Player_factory(const string &name, const string &strategy) {
+  MonteCarloOptions options;
   if (strategy == "Simple") {
     return new SimplePlayer(name);
   }
   else if (strategy == "Human") {
     return new HumanPlayer(name);
   }
+  else if (parse_monte_carlo(strategy, options)) {
+    return new MonteCarloPlayer(name, options);
+  }
+  else if (const BidTable *table = find_bid_table(strategy)) {
+    return new TablePlayer(name, *table);
+  }
 
   assert(false);
   return nullptr;
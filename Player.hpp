@@ -46,6 +46,26 @@ class Player {
   //  The card is removed from the player's hand.
   virtual Card play_card(const Card &led_card, Suit trump) = 0;
 
+  //EFFECTS Empties the player's hand and forgets everything it has seen,
+  //  so that it plays its next game as a newly created player would. Lets
+  //  a Game be reused for many games without creating its players again.
+  //  Every card dealt is played by the end of a hand, so players that keep
+  //  nothing but their hand need not override it.
+  virtual void reset() {}
+
+  //EFFECTS Tells the player how trump was made for the hand about to be
+  //  played, after the dealer has picked up and discarded. Seats are
+  //  counted from this player: 0 is the player itself, 1 the player to its
+  //  left, and so on. The dealer took the upcard if its suit is trump.
+  //  Players that keep no history of the hand ignore it.
+  virtual void see_trump(const Card &upcard, int dealer, int maker,
+                         Suit trump) {}
+
+  //EFFECTS Tells the player that the player in seat, counted as for
+  //  see_trump, played card. Called for every card of the hand, including
+  //  the player's own.
+  virtual void see_play(const Card &card, int seat) {}
+
   // Maximum number of cards in a player's hand
   static const int MAX_HAND_SIZE = 5;
 
@@ -54,6 +74,14 @@ class Player {
   virtual ~Player() {}
 };
 
+//EFFECTS: Returns true if strategy is one Player_factory can create:
+//  "Simple", "Human", "MonteCarlo" optionally followed by ":SAMPLES" and
+//  ":MILLISECONDS", the deals sampled and the time allowed per card played,
+//  or "Table" optionally followed by ":FILE", a BidTable written to FILE,
+//  to bid from a table of the Simple bids or from FILE.
+bool Player_strategy_valid(const std::string &strategy);
+
+//REQUIRES: Player_strategy_valid(strategy)
 //EFFECTS: Returns a pointer to a player with the given name and strategy
 //To create an object that won't go out of scope when the function returns,
 //use "return new Simple(name)" or "return new Human(name)"
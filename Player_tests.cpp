@@ -872,4 +872,119 @@ TEST(test_play_card_removes_card) {
     delete manav;
 }
 
-TEST_MAIN()
\ No newline at end of file
+TEST(test_player_strategy_valid) {
+    ASSERT_TRUE(Player_strategy_valid("Simple"));
+    ASSERT_TRUE(Player_strategy_valid("Human"));
+    ASSERT_TRUE(Player_strategy_valid("MonteCarlo"));
+    ASSERT_TRUE(Player_strategy_valid("MonteCarlo:10"));
+    ASSERT_TRUE(Player_strategy_valid("MonteCarlo:10:5"));
+
+    ASSERT_FALSE(Player_strategy_valid("Random"));
+    ASSERT_FALSE(Player_strategy_valid("MonteCarloX"));
+    ASSERT_FALSE(Player_strategy_valid("MonteCarlo:"));
+    ASSERT_FALSE(Player_strategy_valid("MonteCarlo:0"));
+    ASSERT_FALSE(Player_strategy_valid("MonteCarlo:ten"));
+    ASSERT_FALSE(Player_strategy_valid("MonteCarlo:10:5:1"));
+}
+
+// Without seeing the hand through see_trump and see_play, a Monte Carlo
+// player plays as a Simple player does
+TEST(test_monte_carlo_uninformed_plays_simple) {
+    Player *simple = Player_factory("Manav", "Simple");
+    Player *monte = Player_factory("Monte", "MonteCarlo:10");
+    Card cards[] = {Card(NINE, SPADES), Card(ACE, HEARTS), Card(JACK, CLUBS),
+                    Card(KING, DIAMONDS), Card(TEN, HEARTS)};
+    for (const Card &card : cards) {
+        simple->add_card(card);
+        monte->add_card(card);
+    }
+    ASSERT_EQUAL(monte->lead_card(CLUBS), simple->lead_card(CLUBS));
+    Card led(QUEEN, HEARTS);
+    ASSERT_EQUAL(monte->play_card(led, CLUBS), simple->play_card(led, CLUBS));
+    delete simple;
+    delete monte;
+}
+
+// With its partner's ace winning the trick, a Monte Carlo player keeps its
+// king of the suit led, where a Simple player plays it
+TEST(test_monte_carlo_saves_high_card) {
+    Player *simple = Player_factory("Manav", "Simple");
+    Player *monte = Player_factory("Monte", "MonteCarlo:20");
+    Card cards[] = {Card(KING, HEARTS), Card(NINE, HEARTS), Card(TEN, CLUBS),
+                    Card(QUEEN, CLUBS), Card(KING, DIAMONDS)};
+    for (const Card &card : cards) {
+        simple->add_card(card);
+        monte->add_card(card);
+    }
+
+    // Dealer on the right turns down the nine of diamonds and the player
+    // on the left makes spades and leads the queen of hearts
+    monte->see_trump(Card(NINE, DIAMONDS), 3, 1, SPADES);
+    Card led(QUEEN, HEARTS);
+    monte->see_play(led, 1);
+    monte->see_play(Card(ACE, HEARTS), 2);
+    monte->see_play(Card(TEN, HEARTS), 3);
+
+    ASSERT_EQUAL(simple->play_card(led, SPADES), Card(KING, HEARTS));
+    ASSERT_EQUAL(monte->play_card(led, SPADES), Card(NINE, HEARTS));
+    delete simple;
+    delete monte;
+}
+
+// A player written before reset() was part of Player, which plays the
+// cards it was dealt in order and never orders up
+class FirstCardPlayer : public Player {
+public:
+    const string & get_name() const override {
+        return name;
+    }
+
+    void add_card(const Card &c) override {
+        hand[hand_size++] = c;
+    }
+
+    bool make_trump(const Card &upcard, bool is_dealer,
+                    int round, Suit &order_up_suit) const override {
+        return false;
+    }
+
+    void add_and_discard(const Card &upcard) override {
+        hand[0] = upcard;
+    }
+
+    Card lead_card(Suit trump) override {
+        return hand[next++];
+    }
+
+    Card play_card(const Card &led_card, Suit trump) override {
+        return hand[next++];
+    }
+
+private:
+    string name = "First";
+    Card hand[MAX_HAND_SIZE];
+    int hand_size = 0;
+    int next = 0;
+};
+
+// Players that do not override reset() still compile and play, and reset
+// leaves them as they were
+TEST(test_player_without_reset) {
+    FirstCardPlayer first;
+    Player &player = first;
+    Card cards[] = {Card(NINE, SPADES), Card(ACE, HEARTS), Card(JACK, CLUBS),
+                    Card(KING, DIAMONDS), Card(TEN, HEARTS)};
+    for (const Card &card : cards) {
+        player.add_card(card);
+    }
+    player.reset();
+    Suit order_up_suit = SPADES;
+    ASSERT_FALSE(player.make_trump(Card(NINE, HEARTS), false, 1,
+                                   order_up_suit));
+    ASSERT_EQUAL(player.lead_card(CLUBS), cards[0]);
+    for (int i = 1; i < Player::MAX_HAND_SIZE; ++i) {
+        ASSERT_EQUAL(player.play_card(cards[0], CLUBS), cards[i]);
+    }
+}
+
+TEST_MAIN()
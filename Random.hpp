@@ -0,0 +1,70 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+/* Random.hpp
+ *
+ * A small, fast, seedable pseudorandom number generator
+ */
+
+#include <cassert>
+#include <cstdint>
+
+// xoshiro256** by David Blackman and Sebastiano Vigna, seeded through
+// SplitMix64. See https://prng.di.unimi.it/.
+//
+// Every operation is defined on fixed-width unsigned integers, so a given
+// (seed, stream) produces the same numbers on every platform and compiler.
+// Generators with the same seed and different streams are independent,
+// which lets each game or thread in a parallel run own its generator.
+class Rng {
+public:
+  //EFFECTS Initializes the generator for the given seed and stream
+  explicit Rng(uint64_t seed = 0, uint64_t stream = 0) {
+    uint64_t sm = seed ^ mix(stream + 0x632BE59BD9B4E019);
+    for (uint64_t &word : state) {
+      sm += 0x9E3779B97F4A7C15;
+      word = mix(sm);
+    }
+  }
+
+  //EFFECTS Returns the next 64 random bits
+  uint64_t next() {
+    uint64_t result = rotl(state[1] * 5, 7) * 9;
+    uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+
+  //REQUIRES n > 0
+  //EFFECTS Returns a uniformly distributed number from 0 to n - 1. Draws
+  //  that would bias the result are rejected.
+  uint64_t below(uint64_t n) {
+    assert(n > 0);
+    uint64_t threshold = (0 - n) % n;
+    uint64_t r = next();
+    while (r < threshold) {
+      r = next();
+    }
+    return r % n;
+  }
+
+private:
+  uint64_t state[4];
+
+  static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  // SplitMix64 output function
+  static uint64_t mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+    return z ^ (z >> 31);
+  }
+};
+
+#endif // RANDOM_HPP
@@ -0,0 +1,54 @@
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+
+// Reference values from an independent implementation of the same seeding
+// and generator, so any platform difference shows up here
+TEST(test_rng_known_values) {
+    Rng rng(42);
+    ASSERT_EQUAL(rng.next(), 0xE9D32AD145B05788);
+    ASSERT_EQUAL(rng.next(), 0x469A007E9F730DBC);
+    ASSERT_EQUAL(rng.next(), 0x20A9A5100D030455);
+
+    Rng stream(42, 7);
+    ASSERT_EQUAL(stream.next(), 0x7ECF00F5D6A0A7C2);
+    ASSERT_EQUAL(stream.next(), 0xA740A9A39C8734A6);
+}
+
+TEST(test_rng_same_seed_same_sequence) {
+    Rng a(123, 4);
+    Rng b(123, 4);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQUAL(a.next(), b.next());
+    }
+}
+
+TEST(test_rng_streams_differ) {
+    Rng a(123, 0);
+    Rng b(123, 1);
+    Rng c(124, 0);
+    uint64_t first = a.next();
+    ASSERT_NOT_EQUAL(first, b.next());
+    ASSERT_NOT_EQUAL(first, c.next());
+}
+
+// below(n) stays in range and hits every value
+TEST(test_rng_below_range) {
+    Rng rng(5);
+    vector<int> seen(6, 0);
+    for (int i = 0; i < 6000; ++i) {
+        uint64_t value = rng.below(6);
+        ASSERT_TRUE(value < 6);
+        seen[value]++;
+    }
+    for (int count : seen) {
+        ASSERT_TRUE(count > 800 && count < 1200);
+    }
+    ASSERT_EQUAL(rng.below(1), 0);
+}
+
+TEST_MAIN()
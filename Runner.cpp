@@ -0,0 +1,158 @@
+#include "Runner.hpp"
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+bool is_digit(char c) {
+    return '0' <= c && c <= '9';
+}
+
+// The game indices [begin, end) still waiting in one worker's queue. The
+// owner pops from the front; thieves take the back half.
+class WorkQueue {
+public:
+    void assign(long long begin_in, long long end_in) {
+        lock_guard<mutex> guard(lock);
+        begin = begin_in;
+        end = end_in;
+    }
+
+    bool pop(long long &index) {
+        lock_guard<mutex> guard(lock);
+        if (begin >= end) {
+            return false;
+        }
+        index = begin++;
+        return true;
+    }
+
+    // EFFECTS: Removes the back half of the remaining indices (at least one)
+    //          and stores them in stolen_begin/stolen_end. Returns false if
+    //          the queue is empty.
+    bool steal(long long &stolen_begin, long long &stolen_end) {
+        lock_guard<mutex> guard(lock);
+        if (begin >= end) {
+            return false;
+        }
+        long long mid = begin + (end - begin) / 2;
+        stolen_begin = mid;
+        stolen_end = end;
+        end = mid;
+        return true;
+    }
+
+private:
+    mutex lock;
+    long long begin = 0;
+    long long end = 0;
+};
+
+// EFFECTS: Refills queues[self] from another worker. Returns false once
+//          every queue is empty.
+bool steal_work(vector<unique_ptr<WorkQueue>> &queues, int self) {
+    int num_queues = queues.size();
+    for (int i = 1; i < num_queues; ++i) {
+        long long begin = 0;
+        long long end = 0;
+        if (queues[(self + i) % num_queues]->steal(begin, end)) {
+            queues[self]->assign(begin, end);
+            return true;
+        }
+    }
+    return false;
+}
+
+void run_worker(vector<unique_ptr<WorkQueue>> &queues, int self,
+                const GameFn &play_one, SimStats &stats) {
+    long long index = 0;
+    do {
+        while (queues[self]->pop(index)) {
+            stats.add(play_one(index));
+        }
+    } while (steal_work(queues, self));
+}
+
+} // namespace
+
+int default_thread_count() {
+    unsigned int count = thread::hardware_concurrency();
+    return count > 0 ? count : 1;
+}
+
+// strtoll and strtoull skip leading spaces and take a sign, and strtoull
+// negates a '-' number rather than failing, so text must start with a
+// digit before either is called
+bool parse_number(const string &text, long long &value) {
+    size_t digits = !text.empty() && text[0] == '-' ? 1 : 0;
+    if (digits >= text.size() || !is_digit(text[digits])) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    long long number = strtoll(text.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0') {
+        return false;
+    }
+    value = number;
+    return true;
+}
+
+bool parse_seed(const string &text, uint64_t &seed) {
+    if (text.empty() || !is_digit(text[0])) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long number = strtoull(text.c_str(), &end, 10);
+    if (errno == ERANGE || *end != '\0') {
+        return false;
+    }
+    seed = number;
+    return true;
+}
+
+bool parse_thread_count(const string &text, int &num_threads) {
+    long long number = 0;
+    if (!parse_number(text, number) || number < 1 || number > MAX_THREADS) {
+        return false;
+    }
+    num_threads = number;
+    return true;
+}
+
+SimStats run_parallel(long long num_games, int num_threads,
+                      const GameFn &play_one) {
+    assert(num_threads >= 1);
+
+    vector<unique_ptr<WorkQueue>> queues;
+    for (int i = 0; i < num_threads; ++i) {
+        queues.push_back(make_unique<WorkQueue>());
+        queues[i]->assign(num_games * i / num_threads,
+                          num_games * (i + 1) / num_threads);
+    }
+
+    vector<SimStats> thread_stats(num_threads);
+    vector<thread> workers;
+    for (int i = 1; i < num_threads; ++i) {
+        workers.emplace_back(run_worker, ref(queues), i, cref(play_one),
+                             ref(thread_stats[i]));
+    }
+    run_worker(queues, 0, play_one, thread_stats[0]);
+    for (thread &worker : workers) {
+        worker.join();
+    }
+
+    SimStats total;
+    for (const SimStats &stats : thread_stats) {
+        total.merge(stats);
+    }
+    return total;
+}
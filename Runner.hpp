@@ -0,0 +1,49 @@
+#ifndef RUNNER_HPP
+#define RUNNER_HPP
+/* Runner.hpp
+ *
+ * Plays a batch of independent games across several threads
+ */
+
+#include "Game.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Plays the game with the given index and returns its result. Each call
+// must build its own Game, since calls run concurrently on different threads.
+using GameFn = std::function<GameResult(long long game_index)>;
+
+// Most threads a batch may be asked to run on
+const int MAX_THREADS = 1024;
+
+//EFFECTS Returns the number of hardware threads, or 1 if it is unknown
+int default_thread_count();
+
+//MODIFIES value
+//EFFECTS Reads text, a whole decimal number such as a game count, into
+//  value. Returns false, leaving value alone, if text is not such a
+//  number or does not fit in a long long.
+bool parse_number(const std::string &text, long long &value);
+
+//MODIFIES seed
+//EFFECTS Reads text, a whole decimal number with no sign, into seed.
+//  Returns false, leaving seed alone, if text is not such a number or
+//  does not fit in 64 bits.
+bool parse_seed(const std::string &text, uint64_t &seed);
+
+//MODIFIES num_threads
+//EFFECTS Reads text, a thread count from 1 to MAX_THREADS, into
+//  num_threads. Returns false, leaving num_threads alone, if it is not one.
+bool parse_thread_count(const std::string &text, int &num_threads);
+
+//REQUIRES num_threads >= 1
+//EFFECTS Plays games 0 through num_games - 1 on num_threads worker threads
+//  and returns their merged totals. Each worker starts with an equal slice
+//  of the indices and steals half of another worker's remaining slice when
+//  its own runs out. If play_one depends only on its index, the totals do
+//  not depend on num_threads.
+SimStats run_parallel(long long num_games, int num_threads,
+                      const GameFn &play_one);
+
+#endif // RUNNER_HPP
@@ -0,0 +1,97 @@
+#include "Runner.hpp"
+#include "unit_test_framework.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+// A stand-in for a game whose result depends only on its index
+static GameResult fake_game(long long index) {
+    GameResult result;
+    result.winning_team = index % 2;
+    result.hands = index % 7 + 1;
+    result.euchres = index % 3;
+    result.marches = index % 5 == 0;
+    return result;
+}
+
+TEST(test_run_parallel_plays_each_index_once) {
+    const int num_games = 1000;
+    vector<atomic<int>> plays(num_games);
+    for (atomic<int> &count : plays) {
+        count = 0;
+    }
+
+    SimStats stats = run_parallel(num_games, 8, [&plays](long long index) {
+        plays[index]++;
+        return fake_game(index);
+    });
+
+    ASSERT_EQUAL(stats.games, num_games);
+    for (int i = 0; i < num_games; ++i) {
+        ASSERT_EQUAL(plays[i].load(), 1);
+    }
+}
+
+TEST(test_run_parallel_independent_of_thread_count) {
+    SimStats one = run_parallel(5000, 1, fake_game);
+    for (int threads : {2, 3, 8, 64}) {
+        SimStats many = run_parallel(5000, threads, fake_game);
+        ASSERT_EQUAL(many.games, one.games);
+        ASSERT_EQUAL(many.team_wins[0], one.team_wins[0]);
+        ASSERT_EQUAL(many.team_wins[1], one.team_wins[1]);
+        ASSERT_EQUAL(many.hands, one.hands);
+        ASSERT_EQUAL(many.euchres, one.euchres);
+        ASSERT_EQUAL(many.marches, one.marches);
+    }
+}
+
+// More threads than games leaves some workers with nothing to do
+TEST(test_run_parallel_more_threads_than_games) {
+    SimStats stats = run_parallel(3, 16, fake_game);
+    ASSERT_EQUAL(stats.games, 3);
+    ASSERT_EQUAL(stats.team_wins[0], 2);
+    ASSERT_EQUAL(stats.team_wins[1], 1);
+}
+
+TEST(test_run_parallel_no_games) {
+    SimStats stats = run_parallel(0, 4, fake_game);
+    ASSERT_EQUAL(stats.games, 0);
+}
+
+// Bad text leaves the value as it was
+TEST(test_parse_number) {
+    long long value = 7;
+    ASSERT_TRUE(parse_number("1000", value));
+    ASSERT_EQUAL(value, 1000);
+    ASSERT_TRUE(parse_number("-3", value));
+    ASSERT_EQUAL(value, -3);
+    for (const char *bad : {"", "abc", "5x", " 5", "+5", "-",
+                            "99999999999999999999"}) {
+        ASSERT_FALSE(parse_number(bad, value));
+        ASSERT_EQUAL(value, -3);
+    }
+}
+
+TEST(test_parse_seed) {
+    uint64_t seed = 7;
+    ASSERT_TRUE(parse_seed("18446744073709551615", seed));
+    ASSERT_EQUAL(seed, UINT64_MAX);
+    for (const char *bad : {"", "-1", "x", "18446744073709551616"}) {
+        ASSERT_FALSE(parse_seed(bad, seed));
+        ASSERT_EQUAL(seed, UINT64_MAX);
+    }
+}
+
+TEST(test_parse_thread_count) {
+    int num_threads = 2;
+    ASSERT_TRUE(parse_thread_count("8", num_threads));
+    ASSERT_EQUAL(num_threads, 8);
+    for (const char *bad : {"0", "-4", "1025", "4294967297"}) {
+        ASSERT_FALSE(parse_thread_count(bad, num_threads));
+        ASSERT_EQUAL(num_threads, 8);
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,107 @@
+#ifndef SEAT_HPP
+#define SEAT_HPP
+/* Seat.hpp
+ *
+ * One of the four players of a Game
+ */
+
+#include "Card.hpp"
+#include "Player.hpp"
+#include "SimplePlayer.hpp"
+#include <memory>
+#include <string>
+#include <variant>
+
+// Holds a player of any strategy. Simple players are stored by value and
+// called directly rather than through the Player vtable, so their code
+// can be inlined into Game's bidding and trick loops. Every other
+// strategy, such as Human or MonteCarlo, is created by Player_factory and
+// reached through the Player interface.
+class Seat {
+public:
+  // REQUIRES: Player_strategy_valid(strategy)
+  // EFFECTS: Seats a player with the given name and strategy
+  Seat(const std::string &name, const std::string &strategy) {
+    if (strategy == "Simple") {
+      player.emplace<SimplePlayer>(name);
+    } else {
+      player.emplace<std::unique_ptr<Player>>(Player_factory(name, strategy));
+    }
+  }
+
+  const std::string & get_name() const {
+    if (const SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      return simple->SimplePlayer::get_name();
+    }
+    return std::get<PLUGIN>(player)->get_name();
+  }
+
+  void reset() {
+    if (SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      simple->SimplePlayer::reset();
+    } else {
+      std::get<PLUGIN>(player)->reset();
+    }
+  }
+
+  void add_card(const Card &c) {
+    if (SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      simple->SimplePlayer::add_card(c);
+    } else {
+      std::get<PLUGIN>(player)->add_card(c);
+    }
+  }
+
+  bool make_trump(const Card &upcard, bool is_dealer, int round,
+                  Suit &order_up_suit) const {
+    if (const SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      return simple->SimplePlayer::make_trump(upcard, is_dealer, round,
+                                              order_up_suit);
+    }
+    return std::get<PLUGIN>(player)->make_trump(upcard, is_dealer, round,
+                                                order_up_suit);
+  }
+
+  void add_and_discard(const Card &upcard) {
+    if (SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      simple->SimplePlayer::add_and_discard(upcard);
+    } else {
+      std::get<PLUGIN>(player)->add_and_discard(upcard);
+    }
+  }
+
+  Card lead_card(Suit trump) {
+    if (SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      return simple->SimplePlayer::lead_card(trump);
+    }
+    return std::get<PLUGIN>(player)->lead_card(trump);
+  }
+
+  Card play_card(const Card &led_card, Suit trump) {
+    if (SimplePlayer *simple = std::get_if<SimplePlayer>(&player)) {
+      return simple->SimplePlayer::play_card(led_card, trump);
+    }
+    return std::get<PLUGIN>(player)->play_card(led_card, trump);
+  }
+
+  // Simple players keep no history, so only other players see the hand
+  void see_trump(const Card &upcard, int dealer, int maker, Suit trump) {
+    if (player.index() == PLUGIN) {
+      std::get<PLUGIN>(player)->see_trump(upcard, dealer, maker, trump);
+    }
+  }
+
+  void see_play(const Card &card, int seat) {
+    if (player.index() == PLUGIN) {
+      std::get<PLUGIN>(player)->see_play(card, seat);
+    }
+  }
+
+private:
+  // Index of the alternative reached through the Player interface
+  static const size_t PLUGIN = 0;
+
+  std::variant<std::unique_ptr<Player>, SimplePlayer> player;
+};
+
+#endif // SEAT_HPP
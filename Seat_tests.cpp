@@ -0,0 +1,65 @@
+#include "Seat.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const vector<Card> HAND = {
+    Card(NINE, SPADES), Card(ACE, HEARTS), Card(JACK, CLUBS),
+    Card(KING, DIAMONDS), Card(TEN, HEARTS)};
+
+// A Simple seat makes the same choices as a Simple Player
+TEST(test_seat_simple_matches_player) {
+    Seat seat("Alice", "Simple");
+    Player *player = Player_factory("Alice", "Simple");
+    ASSERT_EQUAL(seat.get_name(), "Alice");
+    for (const Card &card : HAND) {
+        seat.add_card(card);
+        player->add_card(card);
+    }
+
+    Card upcard(QUEEN, HEARTS);
+    for (int round = 1; round <= 2; ++round) {
+        Suit seat_suit = SPADES;
+        Suit player_suit = SPADES;
+        ASSERT_EQUAL(seat.make_trump(upcard, false, round, seat_suit),
+                     player->make_trump(upcard, false, round, player_suit));
+        ASSERT_EQUAL(seat_suit, player_suit);
+    }
+
+    seat.add_and_discard(upcard);
+    player->add_and_discard(upcard);
+    ASSERT_EQUAL(seat.lead_card(HEARTS), player->lead_card(HEARTS));
+    Card led(NINE, DIAMONDS);
+    ASSERT_EQUAL(seat.play_card(led, HEARTS), player->play_card(led, HEARTS));
+    ASSERT_EQUAL(seat.play_card(led, HEARTS), player->play_card(led, HEARTS));
+    delete player;
+}
+
+// Other strategies are reached through the Player interface
+TEST(test_seat_plugin_strategy) {
+    Seat seat("Monte", "MonteCarlo:5");
+    ASSERT_EQUAL(seat.get_name(), "Monte");
+    for (const Card &card : HAND) {
+        seat.add_card(card);
+    }
+    seat.see_trump(Card(NINE, HEARTS), 3, 0, HEARTS);
+    Card led = seat.lead_card(HEARTS);
+    ASSERT_TRUE(find(HAND.begin(), HAND.end(), led) != HAND.end());
+}
+
+// Seats move without copying or losing their players
+TEST(test_seat_move) {
+    vector<Seat> seats;
+    seats.emplace_back("Alice", "Simple");
+    seats.emplace_back("Bob", "MonteCarlo");
+    seats.emplace_back("Carol", "Simple");
+    ASSERT_EQUAL(seats[0].get_name(), "Alice");
+    ASSERT_EQUAL(seats[1].get_name(), "Bob");
+    ASSERT_EQUAL(seats[2].get_name(), "Carol");
+}
+
+TEST_MAIN()
@@ -0,0 +1,105 @@
+#ifndef SIMPLEPLAYER_HPP
+#define SIMPLEPLAYER_HPP
+/* SimplePlayer.hpp
+ *
+ * The "Simple" strategy, defined in full here so Seat can call it without
+ * virtual dispatch and the compiler can inline it into Game
+ */
+
+#include "Player.hpp"
+#include "CardSet.hpp"
+#include <cassert>
+#include <string>
+
+// Bids with two or more face cards or aces of trump, leads its highest
+// non-trump card, follows suit high and otherwise plays low.
+class SimplePlayer : public Player {
+  private:
+    std::string name;
+
+  protected:
+    CardHand hand;
+
+  public:
+    SimplePlayer(const std::string &name) : name(name) {}
+
+    const std::string & get_name() const override {
+        return name;
+    }
+
+    void reset() override {
+      hand = CardHand();
+    }
+
+    void add_card(const Card &c) override {
+      assert(hand.size() < MAX_HAND_SIZE);
+      hand.add(c);
+    }
+
+    bool make_trump(const Card &upcard, bool is_dealer,
+               int round, Suit &order_up_suit) const override {
+      assert(round == 1 || round == 2);
+      CardSet face_or_ace(CardSet::FACE_OR_ACE_BITS);
+
+      if (round == 1) {
+        Suit trump_pot = upcard.get_suit();
+        int valuable = hand.count(face_or_ace & CardSet_trump(trump_pot));
+
+        if (valuable >= 2) {
+          order_up_suit = trump_pot;
+          return true;
+        } else return false;
+      } 
+      else {
+        Suit next = Suit_next(upcard.get_suit());
+        int valuable = hand.count(face_or_ace & CardSet_suit(next));
+
+        if (valuable >= 1 || is_dealer) {
+          order_up_suit = next;
+          return true;
+        } else return false;
+      }
+    }
+
+    void add_and_discard(const Card &upcard) override {
+      assert(hand.size() >= 1 && hand.size() <= MAX_HAND_SIZE);
+      
+      hand.add(upcard);
+      hand.remove(CardSet_lowest(hand.cards(), upcard.get_suit()));
+    }
+
+    Card lead_card(Suit trump) override {
+      assert(!hand.empty());
+
+      CardSet non_trump_cards = hand.cards() & ~CardSet_trump(trump);
+      Card high_card;
+      if (!non_trump_cards.empty()) {
+        high_card = non_trump_cards.highest();
+      }
+      else {
+        high_card = CardSet_highest(hand.cards(), trump);
+      }
+
+      hand.remove(high_card);
+      return high_card;
+    }
+
+    Card play_card(const Card &led_card, Suit trump) override {
+      assert(!hand.empty());
+
+      CardSet follow_suit =
+        hand.cards() & CardSet_suit(led_card.get_suit(trump), trump);
+      Card card_to_play;
+      if (!follow_suit.empty()) {
+        card_to_play = CardSet_highest(follow_suit, trump);
+      }
+      else {
+        card_to_play = CardSet_lowest(hand.cards(), trump);
+      }
+
+      hand.remove(card_to_play);
+      return card_to_play;
+    }
+};
+
+#endif // SIMPLEPLAYER_HPP
@@ -0,0 +1,305 @@
+#include "Solver.hpp"
+#include "SuitMap.hpp"
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+using namespace std;
+
+// For each trump and Card_index, the suit of the card once trump is
+// considered, and the index of the next stronger card of that suit, or -1
+// for the strongest card.
+struct SuitOrderTable {
+  int8_t suit[4][NUM_CARD_INDICES];
+  int8_t above[4][NUM_CARD_INDICES];
+};
+
+static SuitOrderTable make_suit_order_table() {
+  SuitOrderTable order;
+  for (int t = SPADES; t <= DIAMONDS; ++t) {
+    Suit trump = static_cast<Suit>(t);
+    for (int i = 0; i < NUM_CARD_INDICES; ++i) {
+      order.above[t][i] = -1;
+    }
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+      Suit suit = static_cast<Suit>(s);
+      uint64_t members = CardSet_suit(suit, trump).get_bits();
+      const unsigned char *strength = CARD_STRENGTH.strength[t][s];
+      // Link each member to the weakest member stronger than it
+      for (int i = 0; i < NUM_CARD_INDICES; ++i) {
+        if (!(members >> i & 1)) {
+          continue;
+        }
+        order.suit[t][i] = s;
+        for (int j = 0; j < NUM_CARD_INDICES; ++j) {
+          int above = order.above[t][i];
+          if ((members >> j & 1) && strength[i] < strength[j] &&
+              (above < 0 || strength[j] < strength[above])) {
+            order.above[t][i] = j;
+          }
+        }
+      }
+    }
+  }
+  return order;
+}
+
+static const SuitOrderTable SUIT_ORDER = make_suit_order_table();
+
+static Card card_at(int index) {
+  return Card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+}
+
+static int popcount(uint64_t bits) {
+  return __builtin_popcountll(bits);
+}
+
+Solver::Solver(int table_bits) :
+  table(size_t(1) << table_bits), table_mask((uint64_t(1) << table_bits) - 1),
+  nodes(0) {}
+
+void Solver::load(const SolverPosition &position) {
+  assert(0 <= position.leader && position.leader < 4);
+  assert(0 <= position.played && position.played < TRICK_SIZE);
+  for (int seat = 0; seat < 4; ++seat) {
+    hands[seat] = position.hands[seat].get_bits();
+    assert(popcount(hands[seat]) <= Player::MAX_HAND_SIZE);
+  }
+  trump = position.trump;
+  leader = position.leader;
+  played = position.played;
+  for (int i = 0; i < played; ++i) {
+    trick[i] = Card_index(position.trick[i]);
+  }
+}
+
+int Solver::solve(const SolverPosition &position) {
+  load(position);
+  return search(-1, Player::MAX_HAND_SIZE + 1);
+}
+
+int Solver::solve_moves(const SolverPosition &position,
+                        Card moves[Player::MAX_HAND_SIZE],
+                        int tricks[Player::MAX_HAND_SIZE]) {
+  load(position);
+  int seat = (leader + played) % 4;
+  int total = popcount(hands[leader]) + (played > 0 ? 1 : 0);
+
+  uint64_t legal = hands[seat];
+  if (played > 0) {
+    Suit led = static_cast<Suit>(SUIT_ORDER.suit[trump][trick[0]]);
+    uint64_t follow = legal & CardSet_suit(led, trump).get_bits();
+    legal = follow ? follow : legal;
+  }
+
+  int num_moves = 0;
+  for (; legal; legal &= legal - 1) {
+    int card = __builtin_ctzll(legal);
+    int team1_tricks = play(card, -1, Player::MAX_HAND_SIZE + 1);
+    moves[num_moves] = card_at(card);
+    tricks[num_moves] = seat % 2 == 0 ? team1_tricks : total - team1_tricks;
+    ++num_moves;
+  }
+  return num_moves;
+}
+
+// Stores into key the hands relabelled so trump is SPADES, as the table
+// keys them
+void Solver::table_key(uint64_t key[4]) const {
+  CardSet sets[4];
+  for (int seat = 0; seat < 4; ++seat) {
+    sets[seat] = CardSet(hands[seat]);
+  }
+  SuitMap map = SuitMap_canonical(sets, 4, trump);
+  for (int seat = 0; seat < 4; ++seat) {
+    key[seat] = map(hands[seat]);
+  }
+}
+
+Solver::Entry & Solver::entry(const uint64_t key[4]) {
+  uint64_t h = key[0];
+  h = (h ^ (h >> 31)) * 0x9E3779B97F4A7C15 + key[1];
+  h = (h ^ (h >> 29)) * 0xBF58476D1CE4E5B9 + key[2];
+  h = (h ^ (h >> 32)) * 0x94D049BB133111EB + key[3];
+  h = (h ^ (h >> 31)) * 0x9E3779B97F4A7C15 + leader;
+  return table[(h ^ (h >> 29)) & table_mask];
+}
+
+// Stores into moves the cards worth searching for seat, best guess first,
+// and returns how many there are
+int Solver::order_moves(int seat, int moves[Player::MAX_HAND_SIZE]) const {
+  uint64_t hand = hands[seat];
+  uint64_t in_play = hands[0] | hands[1] | hands[2] | hands[3];
+  for (int i = 0; i < played; ++i) {
+    in_play |= uint64_t(1) << trick[i];
+  }
+
+  uint64_t legal = hand;
+  int led = 0;
+  int best = -1;
+  bool partner_winning = false;
+  if (played > 0) {
+    led = SUIT_ORDER.suit[trump][trick[0]];
+    uint64_t follow =
+      hand & CardSet_suit(static_cast<Suit>(led), trump).get_bits();
+    legal = follow ? follow : hand;
+    int winner = trick_winner();
+    best = CARD_STRENGTH.strength[trump][led][trick[winner]];
+    partner_winning = (played - winner) == 2;
+  }
+
+  int keys[Player::MAX_HAND_SIZE];
+  int num_moves = 0;
+  for (; legal; legal &= legal - 1) {
+    int index = __builtin_ctzll(legal);
+    int above = SUIT_ORDER.above[trump][index];
+    while (above >= 0 && !(in_play >> above & 1)) {
+      above = SUIT_ORDER.above[trump][above];
+    }
+    if (above >= 0 && (hand >> above & 1)) {
+      continue;
+    }
+
+    int key;
+    if (played == 0) {
+      int suit = SUIT_ORDER.suit[trump][index];
+      key = 255 - CARD_STRENGTH.strength[trump][suit][index];
+    } else {
+      int strength = CARD_STRENGTH.strength[trump][led][index];
+      bool wins = !partner_winning && best < strength;
+      key = wins ? strength : 256 + strength;
+    }
+
+    int i = num_moves++;
+    for (; i > 0 && key < keys[i - 1]; --i) {
+      keys[i] = keys[i - 1];
+      moves[i] = moves[i - 1];
+    }
+    keys[i] = key;
+    moves[i] = index;
+  }
+  return num_moves;
+}
+
+// Returns the position in the current trick of the card winning it so
+// far, as Trick_winner does for a whole trick
+int Solver::trick_winner() const {
+  const unsigned char *strength =
+    CARD_STRENGTH.strength[trump][SUIT_ORDER.suit[trump][trick[0]]];
+  int winner = 0;
+  for (int i = 1; i < played; ++i) {
+    if (strength[trick[winner]] < strength[trick[i]]) {
+      winner = i;
+    }
+  }
+  return winner;
+}
+
+// Plays the card with index card for the seat to play, searches the rest
+// of the hand, and takes the card back
+int Solver::play(int card, int alpha, int beta) {
+  int seat = (leader + played) % 4;
+  uint64_t bit = uint64_t(1) << card;
+  assert(hands[seat] & bit);
+  hands[seat] ^= bit;
+  trick[played++] = card;
+
+  int value;
+  if (played < TRICK_SIZE) {
+    value = search(alpha, beta);
+  } else {
+    int saved[TRICK_SIZE] = {trick[0], trick[1], trick[2], trick[3]};
+    int old_leader = leader;
+    leader = (leader + trick_winner()) % 4;
+    played = 0;
+    int won = leader % 2 == 0 ? 1 : 0;
+    value = won + search(alpha - won, beta - won);
+    leader = old_leader;
+    played = TRICK_SIZE;
+    for (int i = 0; i < TRICK_SIZE; ++i) {
+      trick[i] = saved[i];
+    }
+  }
+
+  --played;
+  hands[seat] ^= bit;
+  return value;
+}
+
+// Returns the tricks players 0 and 2 take from the current trick on.
+// Fail-soft: a result at or below alpha is an upper bound, and one at or
+// above beta is a lower bound.
+int Solver::search(int alpha, int beta) {
+  ++nodes;
+  int left = 0;
+  uint64_t key[4];
+  if (played == 0) {
+    left = popcount(hands[leader]);
+    if (left <= 1) {
+      if (left == 0) {
+        return 0;
+      }
+      for (played = 0; played < TRICK_SIZE; ++played) {
+        trick[played] = __builtin_ctzll(hands[(leader + played) % 4]);
+      }
+      int winner = (leader + trick_winner()) % 4;
+      played = 0;
+      return winner % 2 == 0 ? 1 : 0;
+    }
+    if (alpha >= left) {
+      return left;
+    }
+    if (beta <= 0) {
+      return 0;
+    }
+    table_key(key);
+    const Entry &cached = entry(key);
+    if (cached.leader == leader && equal(key, key + 4, cached.hands)) {
+      if (cached.lower >= beta || cached.lower == cached.upper) {
+        return cached.lower;
+      }
+      if (cached.upper <= alpha) {
+        return cached.upper;
+      }
+      alpha = max(alpha, int(cached.lower));
+      beta = min(beta, int(cached.upper));
+    }
+  }
+
+  int seat = (leader + played) % 4;
+  bool maximizing = seat % 2 == 0;
+  int moves[Player::MAX_HAND_SIZE];
+  int num_moves = order_moves(seat, moves);
+
+  int window_alpha = alpha;
+  int window_beta = beta;
+  int best = maximizing ? -1 : Player::MAX_HAND_SIZE + 1;
+  for (int i = 0; i < num_moves && alpha < beta; ++i) {
+    int value = play(moves[i], alpha, beta);
+    if (maximizing) {
+      best = max(best, value);
+      alpha = max(alpha, best);
+    } else {
+      best = min(best, value);
+      beta = min(beta, best);
+    }
+  }
+
+  if (played == 0) {
+    Entry &stored = entry(key);
+    if (stored.leader != leader || !equal(key, key + 4, stored.hands)) {
+      copy(key, key + 4, stored.hands);
+      stored.leader = leader;
+      stored.lower = 0;
+      stored.upper = left;
+    }
+    if (best <= window_alpha) {
+      stored.upper = min(int(stored.upper), best);
+    } else if (best >= window_beta) {
+      stored.lower = max(int(stored.lower), best);
+    } else {
+      stored.lower = stored.upper = best;
+    }
+  }
+  return best;
+}
@@ -0,0 +1,97 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+/* Solver.hpp
+ *
+ * Double-dummy trick solver: perfect play with every hand known
+ */
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "Player.hpp"
+#include <cstdint>
+#include <vector>
+
+// A position in the play of a hand. Seats that have already played to the
+// current trick hold one card fewer than the others.
+struct SolverPosition {
+  CardSet hands[4];         // the cards each seat still holds
+  Suit trump = SPADES;
+  int leader = 0;           // seat that leads, or led, the current trick
+  int played = 0;           // cards already played to the current trick
+  Card trick[TRICK_SIZE];   // those cards, starting with the led card
+};
+
+// Searches a position to the end of the hand with alpha-beta pruning.
+//
+// At the start of every trick the result is kept in a transposition table
+// keyed on the four remaining hands and the leader, so orders of play that
+// reach the same cards are searched once. The hands are relabelled by
+// SuitMap_canonical relative to trump first, so positions that differ
+// only in the choice of suits, including positions from other solves with
+// a different trump, share one entry.
+//
+// Moves are tried in order of Card_strength: the cheapest card that takes
+// the trick first, then low cards. A card is skipped when the card just
+// above it in its suit, among the cards still in play, is in the same
+// hand, since both always give the same result.
+//
+// The table stays valid between calls, so one solver can be reused for
+// many positions. A solver is not safe to share between threads.
+class Solver {
+public:
+  // Default number of transposition table entries, as a power of two
+  static const int DEFAULT_TABLE_BITS = 15;
+
+  // EFFECTS: Creates a solver with 2^table_bits table entries
+  explicit Solver(int table_bits = DEFAULT_TABLE_BITS);
+
+  // REQUIRES: position is legal: seats hold MAX_HAND_SIZE or fewer cards,
+  //           no card is in two places, and hand sizes agree with played
+  // EFFECTS: Returns the number of tricks players 0 and 2 take from the
+  //          current trick on when every seat plays perfectly. Players 1
+  //          and 3 take the rest.
+  int solve(const SolverPosition &position);
+
+  // REQUIRES: position is legal, as for solve
+  // MODIFIES: moves, tricks
+  // EFFECTS: Fills moves with each card the seat to play may legally play,
+  //          and tricks[i] with the tricks its side takes from the current
+  //          trick on if it plays moves[i] and everyone then plays
+  //          perfectly. Returns the number of legal moves.
+  int solve_moves(const SolverPosition &position,
+                  Card moves[Player::MAX_HAND_SIZE],
+                  int tricks[Player::MAX_HAND_SIZE]);
+
+  // EFFECTS: Returns the number of positions searched since the solver
+  //          was created
+  long long get_nodes() const { return nodes; }
+
+private:
+  struct Entry {
+    uint64_t hands[4];      // canonical, with trump as SPADES
+    int8_t leader = -1;     // -1 for an empty entry
+    int8_t lower = 0;       // bounds on the tricks players 0 and 2 take
+    int8_t upper = 0;
+  };
+
+  std::vector<Entry> table;
+  uint64_t table_mask;
+  long long nodes;
+
+  // The position being searched
+  uint64_t hands[4];
+  Suit trump;
+  int leader;
+  int played;
+  int trick[TRICK_SIZE];  // by Card_index, so search never builds a Card
+
+  void load(const SolverPosition &position);
+  void table_key(uint64_t key[4]) const;
+  Entry & entry(const uint64_t key[4]);
+  int trick_winner() const;
+  int order_moves(int seat, int moves[Player::MAX_HAND_SIZE]) const;
+  int play(int card, int alpha, int beta);
+  int search(int alpha, int beta);
+};
+
+#endif // SOLVER_HPP
@@ -0,0 +1,202 @@
+#include "Solver.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "SuitMap.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+static const int HAND_SIZE = Player::MAX_HAND_SIZE;
+
+// EFFECTS: Returns the tricks players 0 and 2 take from the current trick
+//          on, by trying every legal card at every turn
+static int brute_force(SolverPosition &pos) {
+    if (pos.played == 0 && pos.hands[pos.leader].empty()) {
+        return 0;
+    }
+    int seat = (pos.leader + pos.played) % 4;
+    CardSet legal = pos.hands[seat];
+    if (pos.played > 0) {
+        CardSet follow = legal & CardSet_suit(pos.trick[0].get_suit(pos.trump),
+                                              pos.trump);
+        legal = follow.empty() ? legal : follow;
+    }
+
+    int best = seat % 2 == 0 ? -1 : 6;
+    for (int index = 0; index < NUM_CARD_INDICES; ++index) {
+        Card card(static_cast<Rank>(index / 4), static_cast<Suit>(index % 4));
+        if (!legal.contains(card)) {
+            continue;
+        }
+        SolverPosition next = pos;
+        next.hands[seat].remove(card);
+        next.trick[next.played++] = card;
+        int value = 0;
+        if (next.played == TRICK_SIZE) {
+            next.leader = (next.leader + Trick_winner(next.trick, next.trump)) % 4;
+            next.played = 0;
+            value = (next.leader % 2 == 0) + brute_force(next);
+        } else {
+            value = brute_force(next);
+        }
+        best = seat % 2 == 0 ? max(best, value) : min(best, value);
+    }
+    return best;
+}
+
+// EFFECTS: Deals hand_size cards to each seat from a randomly shuffled pack
+static SolverPosition random_position(Rng &rng, int hand_size) {
+    Pack pack;
+    pack.shuffle(rng);
+    SolverPosition pos;
+    for (int seat = 0; seat < 4; ++seat) {
+        for (int i = 0; i < hand_size; ++i) {
+            pos.hands[seat].add(pack.deal_one());
+        }
+    }
+    pos.trump = static_cast<Suit>(rng.below(4));
+    pos.leader = static_cast<int>(rng.below(4));
+    return pos;
+}
+
+TEST(test_solver_last_trick) {
+    SolverPosition pos;
+    pos.hands[0].add(Card(ACE, HEARTS));
+    pos.hands[1].add(Card(NINE, SPADES));
+    pos.hands[2].add(Card(KING, HEARTS));
+    pos.hands[3].add(Card(JACK, CLUBS));
+    pos.trump = SPADES;
+    pos.leader = 0;
+    Solver solver;
+    // the left bower trumps the ace of hearts
+    ASSERT_EQUAL(solver.solve(pos), 0);
+    pos.trump = HEARTS;
+    ASSERT_EQUAL(solver.solve(pos), 1);
+}
+
+// The top five trumps take every trick, wherever the lead starts
+TEST(test_solver_top_trumps) {
+    SolverPosition pos;
+    Card trumps[] = {Card(JACK, HEARTS), Card(JACK, DIAMONDS), Card(ACE, HEARTS),
+                     Card(KING, HEARTS), Card(QUEEN, HEARTS)};
+    for (const Card &card : trumps) {
+        pos.hands[1].add(card);
+    }
+    Pack pack;
+    for (int seat : {0, 2, 3}) {
+        while (pos.hands[seat].size() < Player::MAX_HAND_SIZE) {
+            Card card = pack.deal_one();
+            if (!pos.hands[1].contains(card)) {
+                pos.hands[seat].add(card);
+            }
+        }
+    }
+    pos.trump = HEARTS;
+    Solver solver;
+    for (int leader = 0; leader < 4; ++leader) {
+        pos.leader = leader;
+        ASSERT_EQUAL(solver.solve(pos), 0);
+    }
+}
+
+// Solving matches an exhaustive search of small random deals
+TEST(test_solver_matches_brute_force) {
+    Rng rng(280);
+    Solver solver(8);
+    for (int n = 0; n < 300; ++n) {
+        SolverPosition pos = random_position(rng, 1 + n % 3);
+        ASSERT_EQUAL(solver.solve(pos), brute_force(pos));
+    }
+}
+
+// Positions in the middle of a trick, with a small table that collides
+TEST(test_solver_mid_trick_matches_brute_force) {
+    Rng rng(17);
+    Solver solver(4);
+    for (int n = 0; n < 200; ++n) {
+        SolverPosition pos = random_position(rng, 2 + n % 2);
+        int played = static_cast<int>(rng.below(TRICK_SIZE));
+        for (int i = 0; i < played; ++i) {
+            int seat = (pos.leader + i) % 4;
+            Card card = pos.hands[seat].lowest();
+            pos.hands[seat].remove(card);
+            pos.trick[pos.played++] = card;
+        }
+        ASSERT_EQUAL(solver.solve(pos), brute_force(pos));
+    }
+}
+
+// The best move for the side to play is worth what solve says
+TEST(test_solver_moves_match_solve) {
+    Rng rng(5);
+    Solver solver;
+    for (int n = 0; n < 50; ++n) {
+        SolverPosition pos = random_position(rng, Player::MAX_HAND_SIZE);
+        int team1_tricks = solver.solve(pos);
+
+        Card moves[Player::MAX_HAND_SIZE];
+        int tricks[Player::MAX_HAND_SIZE];
+        int num_moves = solver.solve_moves(pos, moves, tricks);
+        ASSERT_EQUAL(num_moves, HAND_SIZE);
+        int best = *max_element(tricks, tricks + num_moves);
+        if (pos.leader % 2 == 0) {
+            ASSERT_EQUAL(best, team1_tricks);
+        } else {
+            ASSERT_EQUAL(best, HAND_SIZE - team1_tricks);
+        }
+    }
+}
+
+// A position with its suits relabelled has the same value, and solving it
+// again with trump moved reuses the table instead of searching
+TEST(test_solver_relabelled_positions) {
+    Rng rng(15);
+    for (int n = 0; n < 20; ++n) {
+        SolverPosition pos = random_position(rng, Player::MAX_HAND_SIZE);
+        Solver solver;
+        int tricks = solver.solve(pos);
+        long long first_nodes = solver.get_nodes();
+
+        Suit trump = static_cast<Suit>((pos.trump + 1 + n % 3) % 4);
+        SuitMap map = SuitMap_inverse(SuitMap_from(trump, n % 2 == 0));
+        SolverPosition relabelled = pos;
+        relabelled.trump = map(SPADES);
+        for (int seat = 0; seat < 4; ++seat) {
+            relabelled.hands[seat] = map(SuitMap_canonical(
+                pos.hands, 4, pos.trump)(pos.hands[seat]));
+        }
+        ASSERT_EQUAL(solver.solve(relabelled), tricks);
+        ASSERT_TRUE(solver.get_nodes() - first_nodes < first_nodes / 10);
+        ASSERT_EQUAL(Solver().solve(relabelled), tricks);
+    }
+}
+
+// Every hand of a recorded game can be solved from its first lead
+TEST(test_solver_recorded_game) {
+    vector<pair<string, string>> players = {
+        {"Edsger", "Simple"}, {"Fran", "Simple"},
+        {"Gabriel", "Simple"}, {"Herb", "Simple"}};
+    Game game(Pack(), 10, true, players);
+    GameRecord record;
+    GameLog log(cout, LOG_NONE);
+    game.play(log, &record);
+
+    Solver solver;
+    for (const HandRecord &hand : record.hands) {
+        SolverPosition pos = HandRecord_position(hand);
+        ASSERT_EQUAL(pos.leader, (hand.dealer + 1) % 4);
+        for (int seat = 0; seat < 4; ++seat) {
+            ASSERT_EQUAL(pos.hands[seat].size(), HAND_SIZE);
+        }
+        int tricks = solver.solve(pos);
+        ASSERT_TRUE(0 <= tricks && tricks <= Player::MAX_HAND_SIZE);
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,114 @@
+#ifndef SUITMAP_HPP
+#define SUITMAP_HPP
+/* SuitMap.hpp
+ *
+ * Relabelling of suits, and canonical forms of hands up to relabelling
+ */
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include <cstdint>
+
+// A relabelling of the four suits that keeps every suit paired with
+// Suit_next, so the rules of the game are unchanged once trump or the
+// upcard suit is relabelled too. Only the reference suit, trump or the
+// upcard suit, and its partner Suit_next are special; the other two suits
+// play the same part and may be swapped.
+//
+// Every such relabelling turns the suits, in the order of enum Suit, so
+// that reference comes first, then may swap HEARTS and DIAMONDS. On a set
+// of cards that is a rotation within each rank's four bits and a swap of
+// two of them, so a cache keyed on cards can canonicalize its keys on
+// every lookup.
+struct SuitMap {
+  Suit reference = SPADES;    // the suit that becomes SPADES
+  bool swap_others = false;   // true to swap HEARTS and DIAMONDS after
+
+  Suit operator()(Suit suit) const {
+    int step = (suit - reference + 4) % 4;
+    return static_cast<Suit>(swap_others && step % 2 == 1 ? 4 - step : step);
+  }
+
+  Card operator()(const Card &card) const {
+    return Card(card.get_rank(), (*this)(card.get_suit()));
+  }
+
+  uint64_t operator()(uint64_t bits) const {
+    // Bits of each rank that stay in its four bits when shifted down
+    static const uint64_t KEPT[4] = {
+      CardSet::ALL, CardSet::SPADES_BITS * 7, CardSet::SPADES_BITS * 3,
+      CardSet::SPADES_BITS
+    };
+    int shift = reference;
+    uint64_t mapped = shift == 0 ? bits :
+      ((bits >> shift) & KEPT[shift]) |
+      ((bits << (4 - shift)) & ~KEPT[shift] & CardSet::ALL);
+    if (swap_others) {
+      uint64_t differ = ((mapped >> 2) ^ mapped) &
+                        (CardSet::SPADES_BITS << HEARTS);
+      mapped ^= differ | (differ << 2);
+    }
+    return mapped;
+  }
+
+  CardSet operator()(CardSet cards) const {
+    return CardSet((*this)(cards.get_bits()));
+  }
+};
+
+//EFFECTS Returns the map that leaves every suit alone
+inline SuitMap SuitMap_identity() {
+  return SuitMap();
+}
+
+//EFFECTS Returns the map that takes reference to SPADES and
+//  Suit_next(reference) to CLUBS, and sends the suit after reference to
+//  HEARTS if swap_others is false, or to DIAMONDS if true
+inline SuitMap SuitMap_from(Suit reference, bool swap_others) {
+  SuitMap map;
+  map.reference = reference;
+  map.swap_others = swap_others;
+  return map;
+}
+
+//EFFECTS Returns the map that undoes map
+inline SuitMap SuitMap_inverse(const SuitMap &map) {
+  // A swap turns the suits the other way, so it is its own inverse
+  if (map.swap_others) {
+    return map;
+  }
+  return SuitMap_from(map(SPADES), false);
+}
+
+//REQUIRES count >= 1
+//EFFECTS Returns the map that makes hands canonical relative to reference.
+//  Reference becomes SPADES and Suit_next(reference) CLUBS; the other two
+//  suits become HEARTS and DIAMONDS in whichever order gives the smaller
+//  mapped hands, compared by bits in order of hands. Sets of hands that
+//  differ only by a relabelling that keeps reference have the same
+//  canonical form.
+inline SuitMap SuitMap_canonical(const CardSet hands[], int count,
+                                 Suit reference) {
+  SuitMap plain = SuitMap_from(reference, false);
+  SuitMap swapped = SuitMap_from(reference, true);
+  for (int i = 0; i < count; ++i) {
+    uint64_t a = plain(hands[i].get_bits());
+    uint64_t b = swapped(hands[i].get_bits());
+    if (a != b) {
+      return a < b ? plain : swapped;
+    }
+  }
+  return plain;
+}
+
+//EFFECTS Returns the map that makes hand canonical relative to reference
+inline SuitMap SuitMap_canonical(CardSet hand, Suit reference) {
+  return SuitMap_canonical(&hand, 1, reference);
+}
+
+//EFFECTS Returns hand relabelled by SuitMap_canonical(hand, reference)
+inline CardSet CardSet_canonical(CardSet hand, Suit reference) {
+  return SuitMap_canonical(hand, reference)(hand);
+}
+
+#endif // SUITMAP_HPP
@@ -0,0 +1,119 @@
+#include "SuitMap.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace std;
+
+// EFFECTS: Returns every set of five euchre cards
+static vector<CardSet> all_hands() {
+    vector<CardSet> hands;
+    const uint64_t euchre = CardSet::EUCHRE_BITS;
+    // Gosper's hack steps through the 24-bit words with five bits set
+    for (uint32_t w = 0x1F; w < (1u << 24); ) {
+        hands.push_back(CardSet(uint64_t(w) << __builtin_ctzll(euchre)));
+        uint32_t low = w & -w;
+        uint32_t ripple = w + low;
+        w = ripple | (((w ^ ripple) >> 2) / low);
+    }
+    return hands;
+}
+
+TEST(test_suit_map_from) {
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        Suit reference = static_cast<Suit>(s);
+        for (bool swap_others : {false, true}) {
+            SuitMap map = SuitMap_from(reference, swap_others);
+            ASSERT_EQUAL(map(reference), SPADES);
+            ASSERT_EQUAL(map(Suit_next(reference)), CLUBS);
+            // every pair of suits stays a pair
+            for (int t = SPADES; t <= DIAMONDS; ++t) {
+                Suit suit = static_cast<Suit>(t);
+                ASSERT_EQUAL(map(Suit_next(suit)), Suit_next(map(suit)));
+            }
+        }
+        ASSERT_NOT_EQUAL(SuitMap_from(reference, false)(Suit_next(
+                             static_cast<Suit>((s + 1) % 4))),
+                         SuitMap_from(reference, true)(Suit_next(
+                             static_cast<Suit>((s + 1) % 4))));
+    }
+}
+
+TEST(test_suit_map_cards) {
+    SuitMap map = SuitMap_from(HEARTS, true);
+    SuitMap inverse = SuitMap_inverse(map);
+    CardSet cards;
+    cards.add(Card(JACK, HEARTS));
+    cards.add(Card(NINE, DIAMONDS));
+    cards.add(Card(ACE, CLUBS));
+    cards.add(Card(TWO, SPADES));
+
+    CardSet mapped = map(cards);
+    ASSERT_EQUAL(mapped.size(), 4);
+    ASSERT_TRUE(mapped.contains(Card(JACK, SPADES)));
+    ASSERT_TRUE(mapped.contains(Card(NINE, CLUBS)));
+    ASSERT_TRUE(mapped.contains(map(Card(ACE, CLUBS))));
+    ASSERT_TRUE(inverse(mapped) == cards);
+    ASSERT_TRUE(SuitMap_identity()(cards) == cards);
+}
+
+// The two suits of the other colour are interchangeable, so about half of
+// the hands are canonical for each upcard suit. By Burnside's lemma there
+// are (42504 + 2292) / 2 classes, where 2292 hands hold the same ranks in
+// both of those suits.
+TEST(test_canonical_hand_count) {
+    vector<CardSet> hands = all_hands();
+    ASSERT_EQUAL(hands.size(), size_t(42504));
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        Suit reference = static_cast<Suit>(s);
+        set<uint64_t> classes;
+        for (CardSet hand : hands) {
+            CardSet canonical = CardSet_canonical(hand, reference);
+            classes.insert(canonical.get_bits());
+            SuitMap swap = SuitMap_inverse(SuitMap_from(reference, true));
+            ASSERT_TRUE(CardSet_canonical(swap(canonical), reference) ==
+                        canonical);
+        }
+        ASSERT_EQUAL(classes.size(), size_t(22398));
+    }
+}
+
+// A Simple player bids the same way on a relabelled hand and upcard
+TEST(test_canonical_simple_bid) {
+    vector<CardSet> hands = all_hands();
+    const Card upcards[] = {Card(NINE, HEARTS), Card(JACK, CLUBS),
+                            Card(ACE, DIAMONDS)};
+    for (size_t i = 0; i < hands.size(); i += 97) {
+        for (const Card &upcard : upcards) {
+            if (hands[i].contains(upcard)) {
+                continue;
+            }
+            SuitMap map = SuitMap_canonical(hands[i], upcard.get_suit());
+            unique_ptr<Player> plain(Player_factory("Plain", "Simple"));
+            unique_ptr<Player> mapped(Player_factory("Mapped", "Simple"));
+            for (CardSet h = hands[i]; !h.empty(); h.remove(h.lowest())) {
+                plain->add_card(h.lowest());
+                mapped->add_card(map(h.lowest()));
+            }
+            for (int round = 1; round <= 2; ++round) {
+                for (bool dealer : {false, true}) {
+                    Suit plain_suit = SPADES;
+                    Suit mapped_suit = SPADES;
+                    bool plain_bid = plain->make_trump(upcard, dealer, round,
+                                                       plain_suit);
+                    ASSERT_EQUAL(mapped->make_trump(map(upcard), dealer,
+                                                    round, mapped_suit),
+                                 plain_bid);
+                    if (plain_bid) {
+                        ASSERT_EQUAL(mapped_suit, map(plain_suit));
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_MAIN()
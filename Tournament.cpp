@@ -0,0 +1,291 @@
+#include "Tournament.hpp"
+#include "Game.hpp"
+#include "Runner.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+using namespace std;
+
+using Matrix = vector<vector<double>>;
+
+// Elo points per unit of the natural log of the odds of winning
+static const double ELO_PER_LOGIT = 400 / log(10.0);
+
+// The test after round k spends 6 / (pi^2 k^2) of the error rate, since
+// those shares sum to one
+static const double PI = acos(-1.0);
+
+// Bisection steps to invert the normal tail, enough for double precision
+static const int QUANTILE_STEPS = 200;
+
+// EFFECTS: Returns the z whose two-sided normal tail is alpha
+static double two_sided_quantile(double alpha) {
+    double low = 0;
+    double high = 40;
+    for (int step = 0; step < QUANTILE_STEPS; ++step) {
+        double mid = (low + high) / 2;
+        (erfc(mid / sqrt(2.0)) > alpha ? low : high) = mid;
+    }
+    return (low + high) / 2;
+}
+
+// Newton steps of the fit, and the change in rating at which it stops
+static const int MAX_FIT_STEPS = 100;
+static const double FIT_TOLERANCE = 1e-9;
+
+// MODIFIES: m
+// EFFECTS: Replaces the square matrix m with its inverse by Gauss-Jordan
+//          elimination. Returns false, leaving m undefined, if m is
+//          singular.
+static bool invert(Matrix &m) {
+    int n = m.size();
+    Matrix inverse(n, vector<double>(n, 0));
+    for (int i = 0; i < n; ++i) {
+        inverse[i][i] = 1;
+    }
+    for (int col = 0; col < n; ++col) {
+        int pivot = col;
+        for (int row = col + 1; row < n; ++row) {
+            if (fabs(m[row][col]) > fabs(m[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (fabs(m[pivot][col]) < 1e-12) {
+            return false;
+        }
+        swap(m[col], m[pivot]);
+        swap(inverse[col], inverse[pivot]);
+        double scale = 1 / m[col][col];
+        for (int k = 0; k < n; ++k) {
+            m[col][k] *= scale;
+            inverse[col][k] *= scale;
+        }
+        for (int row = 0; row < n; ++row) {
+            double factor = m[row][col];
+            if (row == col || factor == 0) {
+                continue;
+            }
+            for (int k = 0; k < n; ++k) {
+                m[row][k] -= factor * m[col][k];
+                inverse[row][k] -= factor * inverse[col][k];
+            }
+        }
+    }
+    m.swap(inverse);
+    return true;
+}
+
+// EFFECTS: Plays a game of team0 in seats 0 and 2 against team1, shuffling
+//          with stream of the options' seed
+static GameResult play_seated(const TournamentOptions &options,
+                              const string &team0, const string &team1,
+                              long long stream) {
+    Game game(Pack(), options.points_to_win, true,
+              {{team0, team0}, {team1, team1}, {team0, team0}, {team1, team1}});
+    game.use_random_shuffle(Rng(options.seed, stream));
+    return game.play(false);
+}
+
+Tournament::Tournament(const TournamentOptions &options_in) :
+    options(options_in), round(0), games(0),
+    wins(options.strategies.size(),
+         vector<long long>(options.strategies.size(), 0)),
+    elo(options.strategies.size(), 0) {
+    assert(options.strategies.size() >= 2);
+    assert(options.games_per_match > 0 && options.games_per_match % 2 == 0);
+    for (const string &strategy : options.strategies) {
+        assert(Player_strategy_valid(strategy));
+        (void)strategy;
+    }
+}
+
+// Returns the strategies from highest rated to lowest, ties in roster order
+vector<int> Tournament::by_rating() const {
+    vector<int> order(elo.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    stable_sort(order.begin(), order.end(),
+                [this](int a, int b) { return elo[a] > elo[b]; });
+    return order;
+}
+
+// Returns the pairs of strategies that play a match this round
+vector<pair<int, int>> Tournament::schedule() const {
+    int n = options.strategies.size();
+    vector<pair<int, int>> matches;
+    if (options.pairing == ROUND_ROBIN) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) {
+                matches.emplace_back(i, j);
+            }
+        }
+        return matches;
+    }
+    // Shifting the pairs every other round links every strategy to the
+    // others, which the fit needs
+    vector<int> order = by_rating();
+    for (int k = n > 2 ? round % 2 : 0; k + 1 < n; k += 2) {
+        matches.emplace_back(order[k], order[k + 1]);
+    }
+    return matches;
+}
+
+void Tournament::play_round() {
+    vector<pair<int, int>> matches = schedule();
+    const long long per_match = options.games_per_match;
+    vector<atomic<long long>> first_wins(matches.size());
+    for (atomic<long long> &count : first_wins) {
+        count = 0;
+    }
+
+    run_parallel(matches.size() * per_match, options.num_threads,
+        [&](long long index) {
+            const pair<int, int> &match = matches[index / per_match];
+            // The first strategy sits in seats 0 and 2 in even games
+            bool swapped = index % 2 == 1;
+            GameResult result = play_seated(
+                options, options.strategies[swapped ? match.second : match.first],
+                options.strategies[swapped ? match.first : match.second],
+                games + index);
+            if ((result.winning_team == 0) != swapped) {
+                first_wins[index / per_match]++;
+            }
+            return result;
+        });
+
+    for (size_t m = 0; m < matches.size(); ++m) {
+        wins[matches[m].first][matches[m].second] += first_wins[m];
+        wins[matches[m].second][matches[m].first] += per_match - first_wins[m];
+    }
+    games += matches.size() * per_match;
+    ++round;
+    fit();
+}
+
+void Tournament::run() {
+    while (!separated() &&
+           games + static_cast<long long>(schedule().size()) *
+                   options.games_per_match <= options.max_games) {
+        play_round();
+    }
+}
+
+// Fits the ratings by Newton's method. The Hessian of the log likelihood
+// is minus a weighted Laplacian of the graph of matches played. Its pseudo
+// inverse, which keeps the average rating at zero, is the covariance of
+// the ratings, and exists when the graph is connected.
+void Tournament::fit() {
+    int n = elo.size();
+    vector<double> theta(n, 0);
+    if (!covariance.empty()) {
+        for (int i = 0; i < n; ++i) {
+            theta[i] = elo[i] / ELO_PER_LOGIT;
+        }
+    }
+    Matrix inverse;
+    for (int step = 0; step < MAX_FIT_STEPS; ++step) {
+        vector<double> gradient(n, 0);
+        Matrix shifted(n, vector<double>(n, 1.0 / n));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                long long played = wins[i][j] + wins[j][i];
+                if (i == j || played == 0) {
+                    continue;
+                }
+                double p = 1 / (1 + exp(theta[j] - theta[i]));
+                gradient[i] += wins[i][j] + 0.5 - (played + 1) * p;
+                double weight = (played + 1) * p * (1 - p);
+                shifted[i][i] += weight;
+                shifted[i][j] -= weight;
+            }
+        }
+        inverse = shifted;
+        if (!invert(inverse)) {
+            covariance.clear();
+            fill(elo.begin(), elo.end(), 0);
+            return;
+        }
+        // Newton steps are damped to one logit, in case of a poor start
+        vector<double> change(n, 0);
+        double largest = 0;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                change[i] += (inverse[i][j] - 1.0 / n) * gradient[j];
+            }
+            largest = max(largest, fabs(change[i]));
+        }
+        double scale = largest > 1 ? 1 / largest : 1;
+        for (int i = 0; i < n; ++i) {
+            theta[i] += change[i] * scale;
+        }
+        if (largest < FIT_TOLERANCE) {
+            break;
+        }
+    }
+
+    covariance.assign(n, vector<double>(n, 0));
+    for (int i = 0; i < n; ++i) {
+        elo[i] = theta[i] * ELO_PER_LOGIT;
+        for (int j = 0; j < n; ++j) {
+            covariance[i][j] = (inverse[i][j] - 1.0 / n) *
+                               ELO_PER_LOGIT * ELO_PER_LOGIT;
+        }
+    }
+}
+
+bool Tournament::separated() const {
+    if (covariance.empty()) {
+        return false;
+    }
+    vector<int> order = by_rating();
+    for (size_t k = 0; k + 1 < order.size(); ++k) {
+        int a = order[k];
+        int b = order[k + 1];
+        double variance = covariance[a][a] + covariance[b][b] -
+                          2 * covariance[a][b];
+        if (elo[a] - elo[b] <= stopping_z() * sqrt(max(variance, 0.0))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double Tournament::stopping_z() const {
+    double alpha = erfc(options.z / sqrt(2.0));
+    double k = max(round, 1);
+    return two_sided_quantile(alpha * 6 / (PI * PI * k * k));
+}
+
+vector<Rating> Tournament::ratings() const {
+    vector<Rating> result;
+    for (int i : by_rating()) {
+        Rating rating;
+        rating.strategy = options.strategies[i];
+        rating.elo = elo[i];
+        rating.margin = covariance.empty()
+            ? numeric_limits<double>::infinity()
+            : options.z * sqrt(max(covariance[i][i], 0.0));
+        for (size_t j = 0; j < wins.size(); ++j) {
+            rating.games += wins[i][j] + wins[j][i];
+            rating.wins += wins[i][j];
+        }
+        result.push_back(rating);
+    }
+    return result;
+}
+
+ostream & operator<<(ostream &os, const Rating &rating) {
+    ios::fmtflags flags = os.flags();
+    streamsize precision = os.precision();
+    os << rating.strategy << " " << fixed << setprecision(1) << rating.elo
+       << " +/- " << rating.margin << ", won " << rating.wins << " of "
+       << rating.games;
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
@@ -0,0 +1,114 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+/* Tournament.hpp
+ *
+ * Rates player strategies by playing them against each other
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// How the strategies are paired in each round
+enum Pairing {
+  ROUND_ROBIN, // every strategy plays every other
+  SWISS,       // each strategy plays one of nearly the same rating
+};
+
+// Settings of a tournament
+struct TournamentOptions {
+  std::vector<std::string> strategies; // each valid for Player_factory
+  Pairing pairing = ROUND_ROBIN;
+  int points_to_win = 10;
+  int games_per_match = 100;    // games per pair of strategies per round
+  long long max_games = 100000; // no round is started past this many
+  double z = 1.96;              // normal quantile for intervals; the test
+                                // to stop has the same error rate overall
+  int num_threads = 1;
+  uint64_t seed = 0;            // the deals depend only on the seed
+};
+
+// A strategy's standing in a tournament
+struct Rating {
+  std::string strategy;
+  double elo = 0;     // on the Elo scale, relative to the average strategy
+  double margin = 0;  // half the width of the confidence interval of elo
+  long long games = 0;
+  long long wins = 0;
+};
+
+// Plays rounds of matches between strategies and rates them. In a match
+// each strategy plays as a partnership of two copies of itself, and the
+// two partnerships trade seats every game, so that neither always deals
+// first. Mixed partnerships, two strategies on one team, are deliberately
+// not played: they would rate partnerships rather than strategies. The
+// games of a round are played in parallel with run_parallel; game n
+// shuffles with its own random stream of the seed, so results do not
+// depend on the number of threads.
+//
+// Ratings are the Bradley-Terry maximum likelihood fit of every game
+// played, on the Elo scale: a strategy rated 400 above another is
+// expected to win ten games for each one it loses. Each pair of
+// strategies that has met is given one extra game split evenly between
+// them, so that a strategy that has won every game still has a finite
+// rating. The fit does not depend on the order the games were played in.
+//
+// Testing for separation after every round gives a false separation many
+// chances, so each test is stricter than the last. The test after round k
+// has error rate alpha * 6 / (pi^2 k^2), where alpha is the two-sided
+// error rate of z. Those rates sum to alpha, so over the whole run a false
+// separation happens with probability at most alpha.
+class Tournament {
+public:
+  // REQUIRES: options has at least two strategies, all valid, and
+  //           games_per_match is even and positive
+  explicit Tournament(const TournamentOptions &options);
+
+  // EFFECTS: Plays one round: in round robin every pair of strategies
+  //          plays a match; in Swiss, strategies are sorted by rating and
+  //          neighbors play, the pairs shifting by one every other round.
+  void play_round();
+
+  // EFFECTS: Plays rounds until the ratings are separated or the next
+  //          round would take the games played past max_games
+  void run();
+
+  // EFFECTS: Returns true if, with the strategies sorted by rating, each
+  //          is rated higher than the next by more than stopping_z()
+  //          standard errors
+  bool separated() const;
+
+  // EFFECTS: Returns the normal quantile separated() tests against after
+  //          the rounds played so far, which grows with every round
+  double stopping_z() const;
+
+  // EFFECTS: Returns the games played so far
+  long long games_played() const { return games; }
+
+  // EFFECTS: Returns the rounds played so far
+  int rounds_played() const { return round; }
+
+  // EFFECTS: Returns every strategy's rating, highest first. Margins are
+  //          infinite until every strategy is connected to every other by
+  //          the matches played.
+  std::vector<Rating> ratings() const;
+
+private:
+  TournamentOptions options;
+  int round;
+  long long games;
+  std::vector<std::vector<long long>> wins; // [i][j]: games i won from j
+  std::vector<double> elo;
+  std::vector<std::vector<double>> covariance; // of elo, empty if unknown
+
+  std::vector<int> by_rating() const;
+  std::vector<std::pair<int, int>> schedule() const;
+  void fit();
+};
+
+//EFFECTS Prints the strategy, rating, confidence interval, wins and games
+std::ostream & operator<<(std::ostream &os, const Rating &rating);
+
+#endif // TOURNAMENT_HPP
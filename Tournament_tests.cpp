@@ -0,0 +1,150 @@
+#include "Tournament.hpp"
+#include "BidTable.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const string EAGER_FILE = "Tournament_tests_eager.bin";
+
+// A table file for a strategy that orders up whatever its hand. The file
+// is written when the first test needs it and removed when the tests end.
+struct EagerTableFile {
+    EagerTableFile() {
+        BidTable eager;
+        for (int key = 0; key < BidTable::num_keys(); ++key) {
+            bool round_two = key % 2 == 1;
+            eager.set_choice(key, BidTable::choice_of(round_two ? HEARTS
+                                                                : SPADES));
+        }
+        ofstream fout(EAGER_FILE, ios::binary);
+        eager.write(fout);
+    }
+
+    ~EagerTableFile() {
+        remove(EAGER_FILE.c_str());
+    }
+};
+
+// EFFECTS: Returns a strategy that orders up whatever its hand
+static string eager_strategy() {
+    static const EagerTableFile file;
+    return "Table:" + EAGER_FILE;
+}
+
+// With two strategies the fit has a closed form: the odds of the leader
+// winning are its wins over its losses, each with half a game added
+TEST(test_tournament_two_strategies) {
+    TournamentOptions options;
+    options.strategies = {eager_strategy(), "Simple"};
+    options.games_per_match = 40;
+    options.seed = 3;
+    Tournament tournament(options);
+    tournament.play_round();
+    tournament.play_round();
+    ASSERT_EQUAL(tournament.games_played(), 80);
+    ASSERT_EQUAL(tournament.rounds_played(), 2);
+
+    vector<Rating> ratings = tournament.ratings();
+    ASSERT_EQUAL(ratings[0].strategy, "Simple");
+    ASSERT_EQUAL(ratings[0].games, 80);
+    ASSERT_EQUAL(ratings[1].games, 80);
+    ASSERT_EQUAL(ratings[0].wins + ratings[1].wins, 80);
+    double odds = (ratings[0].wins + 0.5) / (ratings[1].wins + 0.5);
+    ASSERT_ALMOST_EQUAL(ratings[0].elo - ratings[1].elo, 400 * log10(odds),
+                        1e-6);
+    ASSERT_ALMOST_EQUAL(ratings[0].elo, -ratings[1].elo, 1e-6);
+    ASSERT_TRUE(ratings[0].margin > 0);
+    ASSERT_ALMOST_EQUAL(ratings[0].margin, ratings[1].margin, 1e-6);
+}
+
+// The eager bidder loses clearly, but Table bids as Simple does, so those
+// two cannot be told apart and the tournament stops at max_games
+TEST(test_tournament_adaptive_stop) {
+    TournamentOptions options;
+    options.strategies = {"Simple", eager_strategy()};
+    options.games_per_match = 50;
+    options.num_threads = 4;
+    Tournament clear(options);
+    clear.run();
+    ASSERT_TRUE(clear.separated());
+    ASSERT_TRUE(clear.games_played() < options.max_games);
+    ASSERT_EQUAL(clear.ratings()[1].strategy, options.strategies[1]);
+
+    options.strategies = {"Simple", eager_strategy(), "Table"};
+    options.max_games = 900;
+    Tournament close(options);
+    close.run();
+    ASSERT_FALSE(close.separated());
+    ASSERT_EQUAL(close.games_played(), 900);
+    ASSERT_EQUAL(close.rounds_played(), 6);
+    ASSERT_EQUAL(close.ratings()[2].strategy, options.strategies[1]);
+}
+
+// The test to stop grows stricter with every round, starting stricter
+// than z alone
+TEST(test_tournament_stopping_z_grows) {
+    TournamentOptions options;
+    options.strategies = {"Simple", "Table"};
+    options.games_per_match = 2;
+    Tournament tournament(options);
+    double previous = options.z;
+    for (int i = 0; i < 3; ++i) {
+        tournament.play_round();
+        ASSERT_TRUE(tournament.stopping_z() > previous);
+        previous = tournament.stopping_z();
+    }
+    // The first round's test has error rate 0.05 * 6 / pi^2, about 0.0304
+    options.z = 1.959964;
+    Tournament first(options);
+    first.play_round();
+    ASSERT_ALMOST_EQUAL(first.stopping_z(), 2.1650, 1e-3);
+}
+
+// Results depend only on the seed, not on the threads playing
+TEST(test_tournament_independent_of_thread_count) {
+    TournamentOptions options;
+    options.strategies = {"Simple", eager_strategy(), "Table"};
+    options.games_per_match = 20;
+    options.num_threads = 1;
+    Tournament one(options);
+    one.play_round();
+    options.num_threads = 8;
+    Tournament many(options);
+    many.play_round();
+    vector<Rating> one_ratings = one.ratings();
+    vector<Rating> many_ratings = many.ratings();
+    for (size_t i = 0; i < one_ratings.size(); ++i) {
+        ASSERT_EQUAL(one_ratings[i].strategy, many_ratings[i].strategy);
+        ASSERT_EQUAL(one_ratings[i].wins, many_ratings[i].wins);
+        ASSERT_EQUAL(one_ratings[i].elo, many_ratings[i].elo);
+    }
+}
+
+// Swiss rounds pair neighbors, alternating which strategy sits out
+TEST(test_tournament_swiss) {
+    TournamentOptions options;
+    options.strategies = {"Simple", eager_strategy(), "Table"};
+    options.pairing = SWISS;
+    options.games_per_match = 10;
+    Tournament tournament(options);
+    tournament.play_round();
+    ASSERT_EQUAL(tournament.games_played(), 10);
+    // Only two strategies have played, so the third is not rated yet
+    ASSERT_TRUE(std::isinf(tournament.ratings()[0].margin));
+    ASSERT_EQUAL(tournament.ratings()[2].games, 0);
+    tournament.play_round();
+    ASSERT_EQUAL(tournament.games_played(), 20);
+    for (const Rating &rating : tournament.ratings()) {
+        ASSERT_TRUE(rating.games > 0);
+        ASSERT_FALSE(std::isinf(rating.margin));
+    }
+}
+
+TEST_MAIN()
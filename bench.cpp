@@ -0,0 +1,503 @@
+// Microbenchmarks for the hot paths of a simulated game
+//
+// Usage: bench.exe OUTPUT_FILE [BASELINE_FILE]
+//
+// Each benchmark is calibrated to run for at least TARGET_NS per sample,
+// then timed over SAMPLES samples. Results go to cout as a table and to
+// OUTPUT_FILE as tab-separated values, one benchmark per line. Given the
+// output of an earlier run as BASELINE_FILE, the change in mean time per
+// operation is shown for each benchmark.
+
+#include "BatchSim.hpp"
+#include "BidTable.hpp"
+#include "Card.hpp"
+#include "Deal.hpp"
+#include "Game.hpp"
+#include "GameLog.hpp"
+#include "Pack.hpp"
+#include "PackCorpus.hpp"
+#include "PackParser.hpp"
+#include "Random.hpp"
+#include "SimplePlayer.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Timed runs of each benchmark
+const int SAMPLES = 10;
+
+// Minimum length of one timed run
+const double TARGET_NS = 2e7;
+
+// Results are added here so the compiler cannot drop the work
+static volatile uint64_t sink;
+
+// A benchmark performs n operations each time run(n) is called
+struct Benchmark {
+    string name;
+    function<void(long long n)> run;
+};
+
+struct BenchResult {
+    string name;
+    long long iterations = 0;   // operations per sample
+    double mean_ns = 0;         // per operation, over the samples
+    double stddev_ns = 0;
+    double min_ns = 0;
+    double max_ns = 0;
+};
+
+// EFFECTS: Returns the time taken by run(n) in nanoseconds
+static double time_run(const Benchmark &bench, long long n) {
+    using Clock = chrono::steady_clock;
+    Clock::time_point start = Clock::now();
+    bench.run(n);
+    return chrono::duration<double, nano>(Clock::now() - start).count();
+}
+
+static BenchResult measure(const Benchmark &bench) {
+    BenchResult result;
+    result.name = bench.name;
+    long long n = 1;
+    while (time_run(bench, n) < TARGET_NS && n < (1LL << 40)) {
+        n *= 2;
+    }
+    result.iterations = n;
+
+    vector<double> per_op;
+    for (int i = 0; i < SAMPLES; ++i) {
+        per_op.push_back(time_run(bench, n) / n);
+    }
+    double sum = 0;
+    for (double t : per_op) {
+        sum += t;
+    }
+    result.mean_ns = sum / SAMPLES;
+    double squares = 0;
+    for (double t : per_op) {
+        squares += (t - result.mean_ns) * (t - result.mean_ns);
+    }
+    result.stddev_ns = sqrt(squares / (SAMPLES - 1));
+    result.min_ns = *min_element(per_op.begin(), per_op.end());
+    result.max_ns = *max_element(per_op.begin(), per_op.end());
+    return result;
+}
+
+// EFFECTS: Returns count cards drawn at random from the euchre pack
+static vector<Card> random_cards(int count, Rng &rng) {
+    vector<Card> cards;
+    for (int i = 0; i < count; ++i) {
+        Rank rank = static_cast<Rank>(NINE + rng.below(ACE - NINE + 1));
+        cards.push_back(Card(rank, static_cast<Suit>(rng.below(4))));
+    }
+    return cards;
+}
+
+// Inputs are looked up by i & (NUM_INPUTS - 1) so none are constants
+const int NUM_INPUTS = 1024;
+
+static vector<Benchmark> card_benchmarks() {
+    Rng rng(1);
+    // Enough for NUM_INPUTS tricks laid end to end
+    vector<Card> cards = random_cards(NUM_INPUTS * TRICK_SIZE, rng);
+    vector<Suit> suits;
+    for (int i = 0; i < NUM_INPUTS; ++i) {
+        suits.push_back(static_cast<Suit>(rng.below(4)));
+    }
+    return {
+        {"Card_less(a, b, trump)", [=](long long n) {
+            uint64_t count = 0;
+            for (long long i = 0; i < n; ++i) {
+                int k = i & (NUM_INPUTS - 1);
+                count += Card_less(cards[k], cards[k + 1], suits[k]);
+            }
+            sink = sink + count;
+        }},
+        {"Card_less(a, b, led_card, trump)", [=](long long n) {
+            uint64_t count = 0;
+            for (long long i = 0; i < n; ++i) {
+                int k = i & (NUM_INPUTS - 1);
+                count += Card_less(cards[k], cards[k + 1], cards[k + 2],
+                                   suits[k]);
+            }
+            sink = sink + count;
+        }},
+        {"Card::get_suit(trump)", [=](long long n) {
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                int k = i & (NUM_INPUTS - 1);
+                total += cards[k].get_suit(suits[k]);
+            }
+            sink = sink + total;
+        }},
+        {"Trick_winner", [=](long long n) {
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                int k = i & (NUM_INPUTS - 1);
+                total += Trick_winner(&cards[k], suits[k]);
+            }
+            sink = sink + total;
+        }},
+        // Per trick, resolving up to NUM_INPUTS tricks per call
+        {"Trick_winners", [=](long long n) {
+            vector<int> winners(NUM_INPUTS);
+            uint64_t total = 0;
+            for (long long done = 0; done < n; done += NUM_INPUTS) {
+                int count = min<long long>(n - done, NUM_INPUTS);
+                Trick_winners(cards.data(), suits.data(), count,
+                              winners.data());
+                total += winners[count - 1];
+            }
+            sink = sink + total;
+        }},
+    };
+}
+
+// MODIFIES: corpus
+// EFFECTS: Opens a corpus of 1024 shuffled packs, binary or as text.
+//          Ends the program if it cannot be written or read back.
+static void open_corpus(bool binary, PackCorpus &corpus) {
+    const string filename = "bench_corpus.tmp";
+    ostringstream text;
+    {
+        ofstream fout(filename, ios::binary);
+        unique_ptr<PackCorpusWriter> writer;
+        if (binary) {
+            writer = make_unique<PackCorpusWriter>(fout);
+        }
+        Pack pack;
+        Rng rng(5);
+        array<Card, Pack::PACK_SIZE> cards;
+        for (int n = 0; n < 1024; ++n) {
+            pack.shuffle(rng);
+            for (Card &card : cards) {
+                card = pack.deal_one();
+                text << card << '\n';
+            }
+            if (writer) {
+                writer->write(cards);
+            }
+        }
+        if (!binary) {
+            fout << text.str();
+        }
+    }
+    bool opened = corpus.open(filename);
+    remove(filename.c_str());
+    if (!opened || corpus.size() == 0) {
+        cout << "Error reading " << filename << ": " << corpus.get_error()
+             << endl;
+        exit(1);
+    }
+}
+
+// EFFECTS: Returns the corpus open_corpus opens. Each is opened once, on
+//          first use, so that only its reads are timed.
+static const PackCorpus & bench_corpus(bool binary) {
+    static PackCorpus corpora[2];
+    PackCorpus &corpus = corpora[binary];
+    if (corpus.size() == 0) {
+        open_corpus(binary, corpus);
+    }
+    return corpus;
+}
+
+// Each operation reads pack i of the corpus
+static void corpus_get(bool binary, long long n) {
+    const PackCorpus &corpus = bench_corpus(binary);
+    array<Card, Pack::PACK_SIZE> cards;
+    uint64_t total = 0;
+    for (long long i = 0; i < n; ++i) {
+        corpus.get(i % corpus.size(), cards);
+        total += Card_index(cards[i % Pack::PACK_SIZE]);
+    }
+    sink = sink + total;
+}
+
+static vector<Benchmark> pack_benchmarks() {
+    return {
+        {"Pack::shuffle()", [](long long n) {
+            Pack pack;
+            for (long long i = 0; i < n; ++i) {
+                pack.shuffle();
+            }
+            sink = sink + Card_index(pack.deal_one());
+        }},
+        {"Pack::shuffle(rng)", [](long long n) {
+            Pack pack;
+            Rng rng(2);
+            for (long long i = 0; i < n; ++i) {
+                pack.shuffle(rng);
+            }
+            sink = sink + Card_index(pack.deal_one());
+        }},
+        {"Pack(istream&)", [](long long n) {
+            ostringstream os;
+            for (Pack pack; !pack.empty(); ) {
+                os << pack.deal_one() << '\n';
+            }
+            const string text = os.str();
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                istringstream is(text);
+                Pack pack(is);
+                total += Card_index(pack.deal_one());
+            }
+            sink = sink + total;
+        }},
+        {"PackParser::next_pack", [](long long n) {
+            ostringstream os;
+            for (Pack pack; !pack.empty(); ) {
+                os << pack.deal_one() << '\n';
+            }
+            const string text = os.str();
+            array<Card, Pack::PACK_SIZE> cards;
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                PackParser parser(text.data(), text.size());
+                parser.next_pack(cards);
+                total += Card_index(cards[i % Pack::PACK_SIZE]);
+            }
+            sink = sink + total;
+        }},
+        {"PackCorpus::get binary", [](long long n) {
+            corpus_get(true, n);
+        }},
+        {"PackCorpus::get text", [](long long n) {
+            corpus_get(false, n);
+        }},
+        {"Pack::deal_one", [](long long n) {
+            Pack pack;
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                if (pack.empty()) {
+                    pack.reset();
+                }
+                total += Card_index(pack.deal_one());
+            }
+            sink = sink + total;
+        }},
+    };
+}
+
+// Each operation adds one card to a four card hand and plays one, so the
+// player always holds five cards when it chooses
+static vector<Benchmark> player_benchmarks() {
+    Rng rng(3);
+    Pack pack;
+    pack.shuffle(rng);
+    vector<Card> cards;
+    while (!pack.empty()) {
+        cards.push_back(pack.deal_one());
+    }
+    vector<Suit> suits;
+    for (int i = 0; i < NUM_INPUTS; ++i) {
+        suits.push_back(static_cast<Suit>(rng.below(4)));
+    }
+    return {
+        {"SimplePlayer::add_card+lead_card", [=](long long n) {
+            SimplePlayer player("Bench");
+            for (int i = 0; i < Player::MAX_HAND_SIZE - 1; ++i) {
+                player.add_card(cards[i]);
+            }
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                player.add_card(cards[Player::MAX_HAND_SIZE - 1 + i % 20]);
+                total += Card_index(player.lead_card(suits[i & (NUM_INPUTS - 1)]));
+            }
+            sink = sink + total;
+        }},
+        {"SimplePlayer::add_card+play_card", [=](long long n) {
+            SimplePlayer player("Bench");
+            for (int i = 0; i < Player::MAX_HAND_SIZE - 1; ++i) {
+                player.add_card(cards[i]);
+            }
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                player.add_card(cards[Player::MAX_HAND_SIZE - 1 + i % 20]);
+                const Card &led = cards[(i * 7) % cards.size()];
+                total += Card_index(
+                    player.play_card(led, suits[i & (NUM_INPUTS - 1)]));
+            }
+            sink = sink + total;
+        }},
+    };
+}
+
+// Bidding on varied hands: SimplePlayer counts cards, a table looks the
+// decision up
+static vector<Benchmark> bid_benchmarks() {
+    vector<BidSituation> situations;
+    for (int i = 0; situations.size() < NUM_INPUTS; ++i) {
+        BidSituation situation;
+        situation.hand = Hand_unrank(i * 7919 % NUM_HANDS);
+        situation.upcard = Card(static_cast<Rank>(NINE + i % 6),
+                                static_cast<Suit>(i / 6 % 4));
+        situation.is_dealer = i % 3 == 0;
+        situation.round = 1 + i % 2;
+        if (BidTable::covers(situation)) {
+            situations.push_back(situation);
+        }
+    }
+    vector<SimplePlayer> players;
+    for (const BidSituation &situation : situations) {
+        players.emplace_back("Bench");
+        for (CardSet hand = situation.hand; !hand.empty();
+             hand.remove(hand.lowest())) {
+            players.back().add_card(hand.lowest());
+        }
+    }
+    const BidTable &table = BidTable_simple();
+    return {
+        {"SimplePlayer::make_trump", [=](long long n) {
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                const BidSituation &s = situations[i & (NUM_INPUTS - 1)];
+                Suit suit = SPADES;
+                total += players[i & (NUM_INPUTS - 1)].make_trump(
+                    s.upcard, s.is_dealer, s.round, suit) + suit;
+            }
+            sink = sink + total;
+        }},
+        {"BidTable::make_trump", [=, &table](long long n) {
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                Suit suit = SPADES;
+                total += table.make_trump(situations[i & (NUM_INPUTS - 1)],
+                                          suit) + suit;
+            }
+            sink = sink + total;
+        }},
+    };
+}
+
+static vector<Benchmark> game_benchmarks() {
+    return {
+        {"Game::play (10 points, no log)", [](long long n) {
+            vector<pair<string, string>> players = {
+                {"Adi", "Simple"}, {"Barbara", "Simple"},
+                {"Chi-Chih", "Simple"}, {"Dabbala", "Simple"}};
+            Pack pack;
+            ostringstream os;
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                Game game(pack, 10, true, players);
+                game.use_random_shuffle(Rng(4, i));
+                GameLog log(os, LOG_NONE);
+                total += game.play(log).hands;
+            }
+            sink = sink + total;
+        }},
+        {"Game::reset + play (10 points, no log)", [](long long n) {
+            vector<pair<string, string>> players = {
+                {"Adi", "Simple"}, {"Barbara", "Simple"},
+                {"Chi-Chih", "Simple"}, {"Dabbala", "Simple"}};
+            Game game(Pack(), 10, true, players);
+            ostringstream os;
+            GameLog log(os, LOG_NONE);
+            uint64_t total = 0;
+            for (long long i = 0; i < n; ++i) {
+                game.reset(Rng(4, i));
+                total += game.play(log).hands;
+            }
+            sink = sink + total;
+        }},
+        // Per game, the same games as above played BatchSim::LANES at a
+        // time. Results go to a fixed buffer a chunk at a time, so that
+        // no allocation is timed.
+        {"BatchSim::play (10 points)", [](long long n) {
+            const int CHUNK = 4096;
+            static GameResult results[CHUNK];
+            BatchSim sim(Pack(), 10);
+            uint64_t total = 0;
+            for (long long done = 0; done < n; done += CHUNK) {
+                int count = min<long long>(n - done, CHUNK);
+                sim.play(4, done, count, results);
+                for (int i = 0; i < count; ++i) {
+                    total += results[i].hands;
+                }
+            }
+            sink = sink + total;
+        }},
+    };
+}
+
+// EFFECTS: Reads the mean ns/op of each benchmark from an earlier output
+//          file. Returns an empty map if it cannot be read.
+static map<string, double> read_baseline(const string &filename) {
+    map<string, double> means;
+    ifstream fin(filename);
+    string line;
+    getline(fin, line); // header
+    while (getline(fin, line)) {
+        istringstream fields(line);
+        string name;
+        string mean;
+        if (getline(fields, name, '\t') && getline(fields, mean, '\t')) {
+            means[name] = stod(mean);
+        }
+    }
+    return means;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 2 || argc > 3) {
+        cout << "Usage: bench.exe OUTPUT_FILE [BASELINE_FILE]" << endl;
+        return 1;
+    }
+    map<string, double> baseline;
+    if (argc == 3) {
+        baseline = read_baseline(argv[2]);
+    }
+
+    vector<Benchmark> benchmarks;
+    for (vector<Benchmark> group : {card_benchmarks(), pack_benchmarks(),
+                                    player_benchmarks(), bid_benchmarks(),
+                                    game_benchmarks()}) {
+        benchmarks.insert(benchmarks.end(), group.begin(), group.end());
+    }
+
+    ofstream fout(argv[1]);
+    if (!fout.is_open()) {
+        cout << "Error opening " << argv[1] << endl;
+        return 1;
+    }
+    fout << "benchmark\tns_per_op\tstddev_ns\tmin_ns\tmax_ns\t"
+         << "iterations\tsamples\n";
+    cout << left << setw(36) << "benchmark" << right << setw(12) << "ns/op"
+         << setw(12) << "stddev" << setw(12) << "min" << setw(12) << "max"
+         << (baseline.empty() ? "" : "      change") << "\n";
+    cout << fixed << setprecision(2);
+
+    for (const Benchmark &bench : benchmarks) {
+        BenchResult r = measure(bench);
+        fout << r.name << '\t' << r.mean_ns << '\t' << r.stddev_ns << '\t'
+             << r.min_ns << '\t' << r.max_ns << '\t' << r.iterations << '\t'
+             << SAMPLES << '\n';
+        cout << left << setw(36) << r.name << right << setw(12) << r.mean_ns
+             << setw(12) << r.stddev_ns << setw(12) << r.min_ns
+             << setw(12) << r.max_ns;
+        if (baseline.count(r.name)) {
+            double change = 100 * (r.mean_ns / baseline[r.name] - 1);
+            cout << setw(11) << showpos << change << noshowpos << '%';
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -1,3 +1,4 @@
+#include <array>
 #include <iostream>
 #include <cassert>
 #include <fstream>
@@ -5,298 +6,497 @@
 #include <vector>
 #include <algorithm>
 #include <utility>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <limits>
 
 
 #include "Player.hpp"
 #include "Card.hpp"
 #include "Pack.hpp"
+#include "PackCorpus.hpp"
+#include "Game.hpp"
+#include "GameLog.hpp"
+#include "GameRecord.hpp"
+#include "HandStats.hpp"
+#include "PerfCounters.hpp"
+#include "Runner.hpp"
 
 using namespace std;
 
 
-class Game {
-    private:
-        vector<Player*> players;
-        Card upcard;
-        Pack pack;
-        Suit trump;
-        int points_to_win;
-        int team1score;
-        int team2score;
-        bool bool_shuffle;
-        int dealer_index; //which player is dealer 0-3
-        int hand_num; //what round of game its on
-        
-        bool team1_ordered_up;
-
-
-    public:
-        Game(int points_to_win, bool shuffleOption, 
-            vector<pair<string, string>> inputPlayers, ifstream& packFin) : 
-            pack(packFin), points_to_win(points_to_win), team1score(0), 
-            team2score(0), bool_shuffle(shuffleOption), //2long
-            dealer_index(0), hand_num(0) {
-                
-                for (pair<string, string> p : inputPlayers) {
-                    Player* player = Player_factory(p.first, p.second);
-                    players.push_back(player);
-                }
-        }
-
-        ~Game() { //destructor
-            for (size_t i = 0; i < players.size(); ++i) {
-                delete players[i];
-            } 
-        }
-
-        void play() {
-            // Game starts
-            while (team1score < points_to_win && team2score < points_to_win) {
-                if (bool_shuffle) { 
-                    pack.shuffle(); 
-                }
-                else { 
-                    pack.reset(); 
-                }
+int incorrect_usage() {
+    cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle] "
+        << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
+        << "NAME4 TYPE4 [--simulate N] [--duplicate N] [--threads T] [--seed S] "
+        << "[--log none|summary|full] [--record FILE] [--counters FILE] "
+        << "[--stats FILE] [--stats-every SECONDS]" << endl;
+    return 1;
+}
 
-                cout << "Hand " << hand_num << endl;
 
-                cout << players[dealer_index]->get_name() << " deals" << endl;
-                deal(); //gives each person 5 new cards
+// Where finished games are recorded. Games on different threads take
+// turns writing through the lock.
+struct RecordSink {
+    GameRecordWriter *writer = nullptr;
+    mutex lock;
+};
 
-                cout << upcard << " turned up" << endl;
-                make_trump(); //sets upcard / trump
-                
-                play_hand(); //play the hand out and update each teams score
+// Hardware counter totals of every game. Each thread counts its own
+// games and adds them here through the lock.
+struct CounterSink {
+    bool enabled = false;
+    PhaseTotals totals;
+    mutex lock;
+};
 
-                hand_num++;
-                dealer_index = (dealer_index + 1) % 4;
-            }       
+// Hand statistics of every game, and where snapshots of them are written.
+// Each thread adds its hands to its own shard of the collector.
+struct StatsSink {
+    StatsCollector *collector = nullptr;
+    StatsWriter *writer = nullptr;
+};
 
-            if (team1score > team2score) {
-                cout << players[0]->get_name() << " and " << 
-                players[2]->get_name() << " win!" <<endl;
-            } else {
-                cout << players[1]->get_name() << " and " << 
-                players[3]->get_name() << " win!" <<endl;
-            }
-        }
+// Everything needed to construct a Game
+struct GameSetup {
+    Pack pack;
+    int points_to_win;
+    bool shuffle;
+    vector<pair<string, string>> players;
+    RecordSink records;
+    CounterSink counters;
+    StatsSink stats;
+    const PackCorpus *corpus = nullptr; // deals every hand if not null
+};
 
-        void deal() {
-            int batches[8] = {3, 2, 3, 2, 2, 3, 2, 3};
-            //deal 5 cards to each player starting from left of dealer
-            for (int round = 0; round < 2; ++round) {
-                for ( int i = 0; i < 4; i++) {
-                    
-                    int player_index = (dealer_index + 1 + i) % 4;
+// Settings given after the eleven positional arguments
+struct Options {
+    long long num_games = 0; // 0 plays one narrated game
+    long long num_boards = 0; // duplicate boards played instead of games
+    int num_threads = default_thread_count();
+    bool seeded = false; // shuffle one game at random, not with in shuffles
+    uint64_t seed = 0;
+    bool log_given = false; // otherwise full for one game, none for many
+    LogLevel log_level = LOG_FULL;
+    string record_path; // empty unless games are recorded
+    string counters_path; // empty unless hardware counters are read
+    string stats_path; // empty unless hand statistics are written
+    int stats_every = 0; // seconds between snapshots, 0 for only the last
+};
 
-                    for (int j = 0; j < batches[round*4 + i]; j++){
-                        players[player_index]->add_card(pack.deal_one());
-                    }
+//MODIFIES opts
+//EFFECTS Reads a flag whose value is a word rather than a number. Returns
+//  false if flag is not such a flag or value is not valid for it.
+bool parse_word_option(const string &flag, const string &value, Options &opts) {
+    if (flag == "--seed") {
+        opts.seeded = true;
+        return parse_seed(value, opts.seed);
+    } else if (flag == "--log") {
+        opts.log_given = true;
+        return string_to_log_level(value, opts.log_level);
+    } else if (flag == "--record") {
+        opts.record_path = value;
+        return !value.empty();
+    } else if (flag == "--counters") {
+        opts.counters_path = value;
+        return !value.empty();
+    } else if (flag == "--stats") {
+        opts.stats_path = value;
+        return !value.empty();
+    }
+    return false;
+}
 
-                }
+//MODIFIES opts
+//EFFECTS Reads "--flag value" pairs from argv[12] onward into opts.
+//  Returns false if any flag is unknown or its value is out of range, or
+//  if --stats-every is given without --stats.
+bool parse_options(int argc, char* argv[], Options &opts) {
+    if ((argc - 12) % 2 != 0) {
+        return false;
+    }
+    for (int i = 12; i < argc; i += 2) {
+        string flag = argv[i];
+        if (flag == "--seed" || flag == "--log" || flag == "--record" ||
+            flag == "--counters" || flag == "--stats") {
+            if (!parse_word_option(flag, argv[i + 1], opts)) {
+                return false;
             }
-
-            upcard = pack.deal_one();
+            continue;
         }
-
-        void make_trump() {
-            //Round 1:
-            Suit orderUp = upcard.get_suit();
-            for (int i = 1; i < 5; i++) {
-                int current_player = (dealer_index + i) % 4;
-                bool is_dealer = (current_player == dealer_index);
-                
-                if (players[current_player]->make_trump(upcard, is_dealer, 1, orderUp)){
-                    trump = orderUp;
-                    
-                    cout << players[current_player]->get_name() << 
-                     " orders up " << orderUp <<endl;
-
-                    players[dealer_index]->add_and_discard(upcard);
-                    if (current_player == 0 || current_player == 2) {
-                        team1_ordered_up = true;
-                    } else {
-                        team1_ordered_up = false;
-                    }
-
-                    return;
-                }
-
-                cout << players[current_player]->get_name() <<  " passes" <<endl; 
+        if (flag == "--threads") {
+            if (!parse_thread_count(argv[i + 1], opts.num_threads)) {
+                return false;
             }
+            continue;
+        }
+        long long value = 0;
+        if (!parse_number(argv[i + 1], value) || value < 1) {
+            return false;
+        }
+        if (flag == "--simulate") {
+            opts.num_games = value;
+        } else if (flag == "--duplicate") {
+            opts.num_boards = value;
+        } else if (flag == "--stats-every" &&
+                   value <= numeric_limits<int>::max()) {
+            opts.stats_every = value;
+        } else {
+            return false;
+        }
+    }
+    return opts.stats_every == 0 || !opts.stats_path.empty();
+}
 
-            //Round 2:
-            for (int i = 1; i < 5; i++) {
-                int current_player = (dealer_index + i) % 4;
-                bool is_dealer = (current_player == dealer_index);
-
-                if (players[current_player]->make_trump(upcard, is_dealer, 2, orderUp)){
-                    trump = orderUp;
-
-                    cout << players[current_player]->get_name() << 
-                     " orders up " << orderUp <<endl;
-
+//EFFECTS Plays one game, records it if setup has a record writer,
+//  counts its hardware events if setup's counters are enabled and adds
+//  its hands to setup's stats if it has a collector. With a seed, or
+//  with shuffle in a batch of games, game number game_index shuffles with
+//  its own random stream, so its deals depend only on the seed and index.
+//  With a corpus, it deals its hands from the corpus starting at pack
+//  game_index times the most hands a game can last, so that no two games
+//  deal the same pack unless the corpus is too small for every game and
+//  wraps around.
+GameResult play_game(GameSetup &setup, const Options &opts,
+                     long long game_index, GameLog &log) {
+    // Each thread plays all of its games with one Game, so that players
+    // are only created for a thread's first game
+    thread_local unique_ptr<Game> game;
+    if (!game) {
+        game = make_unique<Game>(setup.pack, setup.points_to_win, setup.shuffle,
+                                 setup.players);
+    } else {
+        game->reset();
+    }
+    // A batch of games all starting from the same pack with in shuffles
+    // would all play the same game
+    if (setup.shuffle && (opts.seeded || opts.num_games > 0)) {
+        game->use_random_shuffle(Rng(opts.seed, game_index));
+    }
+    if (setup.corpus) {
+        game->use_corpus(setup.corpus, game_index *
+                         max_hands_per_game(setup.points_to_win));
+    }
+    // Counters count the thread that opened them, so each thread has its own
+    thread_local unique_ptr<PerfCounters> counters;
+    if (setup.counters.enabled) {
+        if (!counters) {
+            counters = make_unique<PerfCounters>();
+        }
+        game->use_counters(counters.get());
+    }
+    // Each thread claims a shard of the stats for all of its games
+    thread_local StatsShard *stats = nullptr;
+    if (setup.stats.collector) {
+        if (!stats) {
+            stats = setup.stats.collector->claim();
+        }
+        game->use_stats(stats);
+    }
 
-                    if (current_player == 0 || current_player == 2) {
-                        team1_ordered_up = true;
-                    } else {
-                        team1_ordered_up = false;
-                    }
+    GameRecord record;
+    GameResult result = game->play(log, setup.records.writer ? &record : nullptr);
+    if (setup.records.writer) {
+        lock_guard<mutex> guard(setup.records.lock);
+        setup.records.writer->write(record);
+    }
+    if (setup.counters.enabled) {
+        PhaseTotals totals = counters->take_totals();
+        lock_guard<mutex> guard(setup.counters.lock);
+        setup.counters.totals.merge(totals);
+    }
+    return result;
+}
 
-                    return;
+// Writes snapshots of a sink's stats while games are played: one every
+// every_seconds on a thread of its own, if every_seconds is not 0, and a
+// last one when finished. Does nothing if the sink has no collector.
+class StatsReporter {
+public:
+    StatsReporter(const StatsSink &sink_in, int every_seconds) :
+        sink(sink_in), start(Clock::now()) {
+        if (sink.collector && every_seconds > 0) {
+            reporter = thread([this, every_seconds]() {
+                unique_lock<mutex> guard(lock);
+                while (!wake.wait_for(guard, chrono::seconds(every_seconds),
+                                      [this]() { return done; })) {
+                    sink.writer->write(sink.collector->snapshot(), elapsed());
                 }
-                cout << players[current_player]->get_name() <<  " passes" <<endl; 
-            }
+            });
         }
+    }
 
-        void play_hand() {
-            int team1_tricks_won = 0;
-            int team2_tricks_won = 0; 
-
-            int lead_player_index = (dealer_index + 1) % 4;
-            
-            int round_number = 0;
-
-            while (round_number < 5) {
-                Card led_card = players[lead_player_index]->lead_card(trump);
-                string player_name = players[lead_player_index]->get_name();
-                cout << led_card << " led by " << player_name << endl;
-
-                int trick_player_index = lead_player_index;
-                Card trick_card = led_card;
-                Player* trick_player = players[lead_player_index];
-
-                for (int i = 1; i < 4; ++i) {
-                    int next_player_index = (lead_player_index + i) % 4;
-
-                    Player* curr_player = players[next_player_index];
-                    Card curr_card = curr_player->play_card(led_card, trump);
+    StatsReporter(const StatsReporter &) = delete;
+    StatsReporter & operator=(const StatsReporter &) = delete;
 
-                    string curr_player_name = curr_player->get_name();
+    ~StatsReporter() {
+        stop();
+    }
 
-                    cout << curr_card << " played by " << curr_player_name << endl;
+    // EFFECTS: Stops the periodic snapshots, then writes the last one
+    void finish() {
+        stop();
+        if (sink.collector) {
+            sink.writer->write(sink.collector->snapshot(), elapsed());
+            sink.writer->finish();
+        }
+    }
 
-                    if (Card_less(trick_card, curr_card, led_card, trump)) {
-                        trick_card = curr_card;
-                        trick_player_index = next_player_index;
-                        trick_player = curr_player;
-                    }
-                }
+private:
+    using Clock = chrono::steady_clock;
 
-                cout << trick_player->get_name() << " takes the trick" << endl;
-                          
-                lead_player_index = trick_player_index;
+    const StatsSink &sink;
+    Clock::time_point start;
+    thread reporter;
+    mutex lock;
+    condition_variable wake;
+    bool done = false;
 
-                if (trick_player_index % 2 == 0) {
-                    team1_tricks_won += 1;
-                } 
-                else {
-                    team2_tricks_won += 1;
-                }
+    double elapsed() const {
+        return chrono::duration<double>(Clock::now() - start).count();
+    }
 
-                round_number += 1;
+    void stop() {
+        if (reporter.joinable()) {
+            {
+                lock_guard<mutex> guard(lock);
+                done = true;
             }
-
-            award_score(team1_tricks_won, team2_tricks_won);
+            wake.notify_one();
+            reporter.join();
         }
+    }
+};
 
+//EFFECTS Plays opts.num_games games on opts.num_threads threads and prints
+//  the aggregate results. Hand statistics are written as StatsReporter
+//  writes them. Games are not narrated unless --log was given;
+//  then each game's log is written as one block, in the order games end.
+void simulate(GameSetup &setup, const Options &opts) {
+    mutex cout_lock;
+    LogLevel level = opts.log_given ? opts.log_level : LOG_NONE;
+    StatsReporter reporter(setup.stats, opts.stats_every);
+    SimStats stats = run_parallel(opts.num_games, opts.num_threads,
+        [&](long long game_index) {
+            GameLog log(cout, level, GameLog::DEFAULT_BLOCK_SIZE, &cout_lock);
+            return play_game(setup, opts, game_index, log);
+        });
+    reporter.finish();
+    cout << stats;
+}
 
-        void award_score(int team1wins, int team2wins) {
-
-            if (team1wins > team2wins) {
-                cout << players[0]->get_name() << " and " << players[2]->get_name()
-                << " win the hand" << endl;
-
-                if (team1_ordered_up) {
-                    if (team1wins == 3 || team1wins == 4) {
-                        team1score += 1;
-                    }
-                    else if (team1wins == 5) { //march
-                        team1score += 2;
-                            cout << "march!" <<endl;
-                        }
-                } else {
-                    team1score += 2;
-                    cout << "euchred!" <<endl;
-                }
-               
-            }
-            
-            if (team2wins > team1wins) {
-                cout << players[1]->get_name() << " and " 
-                << players[3]->get_name() << " win the hand" << endl;
-                if (!team1_ordered_up) {
-                    if (team2wins == 3 || team2wins == 4) {
-                        team2score += 1;
-                    }
-                    else if (team2wins == 5) { //march
-                        team2score += 2;
-                        cout << "march!" <<endl;
-                    }
-                } else {
-                    team2score += 2;
-                    cout << "euchred!" <<endl;
-                }
+//MODIFIES stats
+//EFFECTS Plays board board_index: one hand, dealt by seat board_index % 4,
+//  then the same deal again with players 0 and 2 in seats 1 and 3 and
+//  players 1 and 3 in seats 0 and 2, and adds it to stats. The deal is
+//  pack board_index of the corpus if setup has one, and otherwise is
+//  shuffled with random stream board_index of the seed.
+void play_duplicate_board(const GameSetup &setup, const Options &opts,
+                long long board_index, DuplicateStats &stats) {
+    // One game for each way the teams sit, reused by all of a thread's boards
+    thread_local unique_ptr<Game> games[2];
+    int net[2];
+    for (int swapped = 0; swapped < 2; ++swapped) {
+        unique_ptr<Game> &game = games[swapped];
+        if (!game) {
+            vector<pair<string, string>> players = setup.players;
+            if (swapped) {
+                swap(players[0], players[1]);
+                swap(players[2], players[3]);
             }
+            game = make_unique<Game>(setup.pack, setup.points_to_win, true,
+                                     players);
+        } else {
+            game->reset();
+        }
+        if (setup.corpus) {
+            game->use_corpus(setup.corpus, board_index);
+        } else {
+            game->use_random_shuffle(Rng(opts.seed, board_index));
+        }
+        GameLog log(cout, LOG_NONE);
+        int team1_net = HandScore_net(game->play_board(board_index % 4, log));
+        net[swapped] = swapped ? -team1_net : team1_net;
+    }
+    stats.add(net[0], net[1]);
+}
 
-            cout << players[0]->get_name() << " and " << players[2]->get_name() 
-            << " have " << team1score << " points" << endl;
+// Duplicate totals of every board. Each thread adds its boards to its own
+// totals, kept on a cache line of their own, and the totals are merged
+// once every board is played. Board scores are whole numbers, so the
+// merged totals do not depend on which thread played which board.
+class DuplicateSink {
+public:
+    explicit DuplicateSink(int num_threads_in) :
+        num_threads(num_threads_in), threads(new PaddedStats[num_threads_in]) {}
+
+    // EFFECTS: Returns totals no other thread has been given
+    DuplicateStats * claim() {
+        int index = claimed.fetch_add(1);
+        assert(index < num_threads);
+        return &threads[index].stats;
+    }
 
-            cout << players[1]->get_name() << " and " << players[3]->get_name() 
-            << " have " << team2score << " points" << endl;
+    // EFFECTS: Returns the sum of every thread's totals
+    DuplicateStats total() const {
+        DuplicateStats sum;
+        for (int i = 0; i < num_threads; ++i) {
+            sum.merge(threads[i].stats);
         }
+        return sum;
+    }
+
+private:
+    struct alignas(64) PaddedStats {
+        DuplicateStats stats;
+    };
 
+    int num_threads;
+    unique_ptr<PaddedStats[]> threads;
+    atomic<int> claimed{0};
 };
 
-int incorrect_usage() {
-    cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle] "
-        << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
-        << "NAME4 TYPE4" << endl;
-    return 1;
+//EFFECTS Plays opts.num_boards duplicate boards on opts.num_threads
+//  threads and prints the net points per board of players 0 and 2
+void play_duplicate(const GameSetup &setup, const Options &opts) {
+    DuplicateSink sink(opts.num_threads);
+    run_parallel(opts.num_boards, opts.num_threads,
+        [&](long long board_index) {
+            // Each thread claims its totals for all of its boards
+            thread_local DuplicateStats *stats = nullptr;
+            if (!stats) {
+                stats = sink.claim();
+            }
+            play_duplicate_board(setup, opts, board_index, *stats);
+            return GameResult();
+        });
+    cout << sink.total();
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 12) {
+    Options opts;
+    if (argc < 12 || !parse_options(argc, argv, opts)) {
         return incorrect_usage();
     } else if (stoi(argv[3]) < 1 || stoi(argv[3]) > 100){
         return incorrect_usage();
     } else if (string(argv[2]) != "shuffle" && string(argv[2]) != "noshuffle") {
         return incorrect_usage();
-    } else if (string(argv[5]) != "Simple" && string(argv[5]) != "Human") {
-        return incorrect_usage();
-    } else if (string(argv[7]) != "Simple" && string(argv[7]) != "Human") {
+    } else if (opts.seeded && string(argv[2]) != "shuffle") {
         return incorrect_usage();
-    } else if (string(argv[9]) != "Simple" && string(argv[9]) != "Human") {
-        return incorrect_usage();
-    } else if (string(argv[11]) != "Simple" && string(argv[11]) != "Human") {
+    } else if (opts.num_boards > 0 && (opts.num_games > 0 || opts.log_given ||
+               !opts.record_path.empty() || !opts.counters_path.empty() ||
+               !opts.stats_path.empty())) {
         return incorrect_usage();
     }
+    // Batch games run on many threads at once, which cannot share the
+    // console with a Human player
+    bool batch = opts.num_games > 0 || opts.num_boards > 0;
+    for (int i = 5; i <= 11; i += 2) {
+        if (!Player_strategy_valid(argv[i]) ||
+            (batch && string(argv[i]) == "Human")) {
+            return incorrect_usage();
+        }
+    }
 
-    cout << string(argv[0]) << " " << string(argv[1]) << " " << string(argv[2]) << " " 
-        << string(argv[3]) << " " << string(argv[4]) << " " << string(argv[5]) << " " 
-        << string(argv[6]) << " " << string(argv[7]) << " " << string(argv[8]) << " " 
-        << string(argv[9]) << " " << string(argv[10]) << " " << string(argv[11]) << " " 
-        <<endl;
-
-    ifstream fin(argv[1]);
+    if (opts.num_games == 0 && opts.num_boards == 0) {
+        for (int i = 0; i < argc; ++i) {
+            cout << string(argv[i]) << " ";
+        }
+        cout << endl;
+    }
 
-    
-    if(!fin.is_open()) {
-        cout << "Error opening " << string(argv[1]) << endl;
+    // The pack file may be a corpus of many packs, text or binary
+    PackCorpus corpus;
+    if (!corpus.open(argv[1])) {
+        if (!corpus.file_found()) {
+            cout << "Error opening " << string(argv[1]) << endl;
+        } else {
+            cout << "Error reading " << string(argv[1]) << ": "
+                 << corpus.get_error() << endl;
+        }
         return 1;
     }
+    array<Card, Pack::PACK_SIZE> cards;
+    corpus.get(0, cards);
 
-    bool shuffle = (string(argv[2]) == "shuffle");
-    int points_to_win = stoi(argv[3]);
-    vector<pair<string, string>> inputPlayers;
-    inputPlayers.push_back(make_pair(string(argv[4]), string(argv[5])));
-    inputPlayers.push_back(make_pair(string(argv[6]), string(argv[7])));
-    inputPlayers.push_back(make_pair(string(argv[8]), string(argv[9])));
-    inputPlayers.push_back(make_pair(string(argv[10]), string(argv[11])));
+    GameSetup setup = {Pack(cards), stoi(argv[3]), string(argv[2]) == "shuffle"};
+    for (int i = 4; i <= 10; i += 2) {
+        setup.players.push_back(make_pair(string(argv[i]), string(argv[i + 1])));
+    }
+    // Without shuffling, a corpus of many packs deals every hand in turn
+    if (corpus.size() > 1 && !setup.shuffle) {
+        setup.corpus = &corpus;
+    }
 
-    Game game(points_to_win, shuffle, inputPlayers, fin);
-    game.play();
-}
+    if (opts.num_boards > 0) {
+        // Boards are shuffled at random unless noshuffle deals them from a
+        // corpus of many packs
+        if (!setup.shuffle && !setup.corpus) {
+            return incorrect_usage();
+        }
+        play_duplicate(setup, opts);
+        return 0;
+    }
 
+    ofstream record_file;
+    unique_ptr<GameRecordWriter> record_writer;
+    if (!opts.record_path.empty()) {
+        record_file.open(opts.record_path, ios::binary);
+        if (!record_file.is_open()) {
+            cout << "Error opening " << opts.record_path << endl;
+            return 1;
+        }
+        record_writer = make_unique<GameRecordWriter>(record_file);
+        setup.records.writer = record_writer.get();
+    }
 
+    ofstream counters_file;
+    if (!opts.counters_path.empty()) {
+        counters_file.open(opts.counters_path);
+        if (!counters_file.is_open()) {
+            cout << "Error opening " << opts.counters_path << endl;
+            return 1;
+        }
+        setup.counters.enabled = true;
+    }
+
+    ofstream stats_file;
+    unique_ptr<StatsCollector> stats_collector;
+    unique_ptr<StatsWriter> stats_writer;
+    if (!opts.stats_path.empty()) {
+        stats_file.open(opts.stats_path);
+        if (!stats_file.is_open()) {
+            cout << "Error opening " << opts.stats_path << endl;
+            return 1;
+        }
+        stats_collector = make_unique<StatsCollector>(opts.num_threads);
+        stats_writer = make_unique<StatsWriter>(
+            stats_file, StatsFormat_of_path(opts.stats_path));
+        setup.stats.collector = stats_collector.get();
+        setup.stats.writer = stats_writer.get();
+    }
+
+    if (opts.num_games > 0) {
+        simulate(setup, opts);
+        counters_file << setup.counters.totals;
+        return 0;
+    }
+
+    // A Human player's prompts go straight to cout, so narration around
+    // them must not be held back in the buffer
+    bool interactive = false;
+    for (const pair<string, string> &player : setup.players) {
+        interactive = interactive || player.second == "Human";
+    }
+    GameLog log(cout, opts.log_level,
+                interactive ? 0 : GameLog::DEFAULT_BLOCK_SIZE);
+    StatsReporter reporter(setup.stats, opts.stats_every);
+    play_game(setup, opts, 0, log);
+    reporter.finish();
+    counters_file << setup.counters.totals;
+}
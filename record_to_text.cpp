@@ -0,0 +1,44 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+
+#include "GameLog.hpp"
+#include "GameRecord.hpp"
+
+using namespace std;
+
+int incorrect_usage() {
+    cout << "Usage: record_to_text.exe RECORD_FILENAME [none|summary|full]"
+        << endl;
+    return 1;
+}
+
+// Prints the narration of every game in a file written by
+// euchre.exe --record, in the same text euchre.exe prints
+int main(int argc, char* argv[]) {
+    LogLevel level = LOG_FULL;
+    if (argc != 2 && argc != 3) {
+        return incorrect_usage();
+    } else if (argc == 3 && !string_to_log_level(argv[2], level)) {
+        return incorrect_usage();
+    }
+
+    ifstream fin(argv[1], ios::binary);
+    if (!fin.is_open()) {
+        cout << "Error opening " << string(argv[1]) << endl;
+        return 1;
+    }
+
+    GameRecordReader reader(fin);
+    GameLog log(cout, level);
+    GameRecord game;
+    while (reader.read(game)) {
+        GameRecord_narrate(game, log);
+    }
+    log.flush();
+
+    if (!fin.eof()) {
+        cout << "Error reading " << string(argv[1]) << endl;
+        return 1;
+    }
+}
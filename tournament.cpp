@@ -0,0 +1,101 @@
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Player.hpp"
+#include "Runner.hpp"
+#include "Tournament.hpp"
+
+using namespace std;
+
+int incorrect_usage() {
+    cout << "Usage: tournament.exe STRATEGY1 STRATEGY2 [STRATEGY...] "
+        << "[--pairing round-robin|swiss] [--games N] [--max-games N] "
+        << "[--points P] [--threads T] [--seed S] [--z Z]" << endl;
+    return 1;
+}
+
+//MODIFIES z
+//EFFECTS Reads text, a positive finite number, into z. Returns false,
+//  leaving z alone, if it is not one.
+bool parse_z(const string &text, double &z) {
+    if (text.empty() || !('0' <= text[0] && text[0] <= '9')) {
+        return false;
+    }
+    char *end = nullptr;
+    errno = 0;
+    double value = strtod(text.c_str(), &end);
+    if (errno == ERANGE || *end != '\0' || !isfinite(value) || value <= 0) {
+        return false;
+    }
+    z = value;
+    return true;
+}
+
+//MODIFIES options
+//EFFECTS Reads one "--flag value" pair into options. Returns false if
+//  flag is unknown or value is out of range.
+bool parse_option(const string &flag, const string &value,
+                  TournamentOptions &options) {
+    if (flag == "--pairing") {
+        options.pairing = value == "swiss" ? SWISS : ROUND_ROBIN;
+        return value == "swiss" || value == "round-robin";
+    } else if (flag == "--seed") {
+        return parse_seed(value, options.seed);
+    } else if (flag == "--z") {
+        return parse_z(value, options.z);
+    } else if (flag == "--threads") {
+        return parse_thread_count(value, options.num_threads);
+    }
+    long long number = 0;
+    if (!parse_number(value, number) || number < 1) {
+        return false;
+    }
+    if (flag == "--games") {
+        options.games_per_match = number;
+        return number % 2 == 0 && number <= numeric_limits<int>::max();
+    } else if (flag == "--max-games") {
+        options.max_games = number;
+    } else if (flag == "--points") {
+        options.points_to_win = number;
+        return number <= 100;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Plays the strategies named on the command line against each other until
+// their ratings separate, then prints the ratings from highest to lowest
+int main(int argc, char* argv[]) {
+    TournamentOptions options;
+    options.num_threads = default_thread_count();
+    int i = 1;
+    for (; i < argc && string(argv[i]).compare(0, 2, "--") != 0; ++i) {
+        if (!Player_strategy_valid(argv[i]) || string(argv[i]) == "Human") {
+            return incorrect_usage();
+        }
+        options.strategies.push_back(argv[i]);
+    }
+    if (options.strategies.size() < 2 || (argc - i) % 2 != 0) {
+        return incorrect_usage();
+    }
+    for (; i < argc; i += 2) {
+        if (!parse_option(argv[i], argv[i + 1], options)) {
+            return incorrect_usage();
+        }
+    }
+
+    Tournament tournament(options);
+    tournament.run();
+    cout << tournament.games_played() << " games in "
+         << tournament.rounds_played() << " rounds, ratings "
+         << (tournament.separated() ? "separated" : "not separated") << endl;
+    for (const Rating &rating : tournament.ratings()) {
+        cout << rating << endl;
+    }
+}